@@ -0,0 +1,122 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+# Compares two result files written with `runner.rb --json`
+#
+#   ruby benchmark/compare.rb baseline.json candidate.json [--alpha 0.01] [--min-change 2]
+#                             [--fail-on-regression]
+#
+# Each benchmark present in both files is tested with a two-sided
+# Mann-Whitney U test on its per-iteration samples. A change is reported as
+# significant only if p < alpha and the median moved by at least
+# --min-change percent, so tiny but consistent shifts are not flagged.
+
+require 'json'
+require 'optparse'
+
+module Benchmarks
+  module Compare
+    # Two-sided Mann-Whitney U test with tie correction, using the normal
+    # approximation. Returns the p-value.
+    def self.mann_whitney_p(a, b)
+      n1 = a.size
+      n2 = b.size
+      n = n1 + n2
+
+      combined = a.map { |v| [v, 0] } + b.map { |v| [v, 1] }
+      combined.sort_by!(&:first)
+
+      rank_sum_a = 0.0
+      tie_term = 0.0
+      i = 0
+      while i < n
+        j = i
+        j += 1 while j + 1 < n && combined[j + 1][0] == combined[i][0]
+        ties = j - i + 1
+        average_rank = (i + j + 2) / 2.0
+        (i..j).each { |k| rank_sum_a += average_rank if combined[k][1].zero? }
+        tie_term += ties**3 - ties
+        i = j + 1
+      end
+
+      u = rank_sum_a - n1 * (n1 + 1) / 2.0
+      mean = n1 * n2 / 2.0
+      variance = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+      return 1.0 if variance <= 0
+
+      z = ((u - mean).abs - 0.5) / Math.sqrt(variance)
+      z = 0.0 if z.negative?
+      Math.erfc(z / Math.sqrt(2))
+    end
+
+    def self.median(values)
+      sorted = values.sort
+      mid = sorted.size / 2
+      sorted.size.odd? ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2.0
+    end
+
+    def self.load(path)
+      JSON.parse(File.read(path), symbolize_names: true)[:results].to_h do |entry|
+        ["#{entry[:suite]}/#{entry[:name]}", entry]
+      end
+    end
+
+    def self.run(base_path, new_path, alpha: 0.01, min_change: 2.0)
+      base = load(base_path)
+      candidate = load(new_path)
+      names = base.keys & candidate.keys
+
+      puts format("%-58s %12s %12s %9s %10s  %s", "Benchmark", "Base p50", "New p50", "Change", "p-value", "Verdict")
+
+      verdicts = names.map do |name|
+        a = base[name][:samples_us]
+        b = candidate[name][:samples_us]
+        base_median = median(a)
+        change = base_median.zero? ? 0.0 : (median(b) - base_median) / base_median * 100
+
+        if a.size < 3 || b.size < 3
+          p_value = nil
+          verdict = "too few samples"
+        else
+          p_value = mann_whitney_p(a, b)
+          verdict =
+            if p_value < alpha && change.abs >= min_change
+              change.negative? ? "faster" : "SLOWER"
+            else
+              "no change"
+            end
+        end
+
+        puts format("%-58s %10.2fus %10.2fus %+8.1f%% %10s  %s",
+                    name[0, 58], base_median, median(b), change,
+                    p_value ? format("%.2g", p_value) : "-", verdict)
+        verdict
+      end
+
+      only_base = base.keys - candidate.keys
+      only_new = candidate.keys - base.keys
+      puts "\nOnly in #{base_path}: #{only_base.join(', ')}" unless only_base.empty?
+      puts "Only in #{new_path}: #{only_new.join(', ')}" unless only_new.empty?
+
+      puts format("\n%d compared: %d faster, %d slower, %d unchanged (alpha %.3g, min change %.1f%%)",
+                  verdicts.size, verdicts.count("faster"), verdicts.count("SLOWER"),
+                  verdicts.count("no change"), alpha, min_change)
+      verdicts
+    end
+  end
+end
+
+if __FILE__ == $0
+  options = { alpha: 0.01, min_change: 2.0, fail_on_regression: false }
+  parser = OptionParser.new do |opts|
+    opts.banner = "usage: compare.rb BASELINE.json CANDIDATE.json [options]"
+    opts.on("--alpha P", Float, "Significance level (default 0.01)") { |v| options[:alpha] = v }
+    opts.on("--min-change PCT", Float, "Smallest median change to report (default 2)") { |v| options[:min_change] = v }
+    opts.on("--fail-on-regression", "Exit with status 1 if anything got slower") { options[:fail_on_regression] = true }
+  end
+  parser.parse!
+  abort parser.banner unless ARGV.size == 2
+
+  verdicts = Benchmarks::Compare.run(ARGV[0], ARGV[1], alpha: options[:alpha], min_change: options[:min_change])
+  exit 1 if options[:fail_on_regression] && verdicts.include?("SLOWER")
+end
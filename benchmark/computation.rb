@@ -2,6 +2,7 @@
 
 require 'benchmark'
 require_relative '../lib/mquickjs'
+require_relative 'results'
 
 module Benchmarks
   class Computation
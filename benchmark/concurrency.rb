@@ -0,0 +1,148 @@
+# frozen_string_literal: true
+
+require 'etc'
+require_relative '../lib/mquickjs'
+require_relative 'results'
+
+module Benchmarks
+  class Concurrency
+    # Workload mix, run round-robin by every thread. Each entry is one eval.
+    WORKLOAD = [
+      { name: "arithmetic", code: "var s = 0; for (var i = 0; i < 2000; i++) s += i * 2; s" },
+      { name: "json", code: <<~JS },
+        var o = { id: 7, tags: ["a", "b", "c"], nested: { ok: true, n: [1, 2, 3] } };
+        var r; for (var i = 0; i < 50; i++) r = JSON.parse(JSON.stringify(o)); r.id
+      JS
+      { name: "string", code: "var p = []; for (var i = 0; i < 200; i++) p.push('item' + i); p.join(',').length" },
+      { name: "regex", code: "var m = 0; for (var i = 0; i < 100; i++) if (/(\\w+)@(\\w+)\\.com/.test('mail bob@example.com')) m++; m" }
+    ].freeze
+
+    def self.run(duration: 2.0, max_threads: Etc.nprocessors)
+      puts "\n=== Concurrency Benchmark ==="
+      puts "Duration: #{duration}s per thread count, CPUs: #{Etc.nprocessors}"
+      puts "Workload: #{WORKLOAD.map { |w| w[:name] }.join(', ')} (one sandbox per thread)"
+
+      report("Threads", duration, max_threads) { |threads| measure(threads, duration) }
+      puts "\n  Efficiency is throughput relative to perfect linear scaling from 1 thread."
+      puts "  Around 100/threads % means evals are serialized (the GVL is held during eval)."
+
+      return unless defined?(Ractor)
+
+      Warning[:experimental] = false
+      report("Ractors", duration, max_threads) { |ractors| measure_ractors(ractors, duration) }
+      puts "\n  Each Ractor has its own GVL, so evals in different Ractors run in parallel."
+    end
+
+    def self.report(kind, duration, max_threads)
+      puts format("\n  %-8s %10s %12s %10s %10s %10s %12s %11s",
+                  kind, "Evals", "Evals/s", "p50 (us)", "p90 (us)", "p99 (us)", "Worst p99", "Efficiency")
+
+      baseline = nil
+      thread_counts(max_threads).each do |threads|
+        results, elapsed = yield(threads)
+        all = results.flat_map { |r| r[:latencies] }.sort
+        throughput = all.size / elapsed
+        baseline ||= throughput
+        worst_p99 = results.map { |r| percentile(r[:latencies].sort, 99) }.max
+        Results.add(suite: "concurrency", name: "#{threads} #{kind.downcase}", samples_us: all, total_s: elapsed)
+
+        puts format("  %-8d %10d %12.0f %10.1f %10.1f %10.1f %12.1f %10.0f%%",
+                    threads, all.size, throughput,
+                    percentile(all, 50), percentile(all, 90), percentile(all, 99),
+                    worst_p99, throughput / (baseline * threads) * 100)
+      end
+    end
+
+    # 1, 2, 4, ... up to max_threads, always including max_threads
+    def self.thread_counts(max_threads)
+      counts = []
+      n = 1
+      while n < max_threads
+        counts << n
+        n *= 2
+      end
+      counts << max_threads
+    end
+
+    # Runs `threads` workers for `duration` seconds. Returns each worker's
+    # per-eval latencies in microseconds, and the wall time of the window.
+    def self.measure(threads, duration)
+      ready = Queue.new
+      start_gate = Queue.new
+      workers = Array.new(threads) do
+        Thread.new do
+          sandbox = MQuickJS::Sandbox.new(memory_limit: 1_000_000, timeout_ms: 10_000)
+          WORKLOAD.each { |w| sandbox.eval(w[:code]) } # warmup
+          latencies = []
+
+          ready << true
+          deadline = start_gate.pop
+          i = 0
+          loop do
+            t0 = now
+            sandbox.eval(WORKLOAD[i % WORKLOAD.size][:code])
+            t1 = now
+            latencies << (t1 - t0) * 1_000_000
+            i += 1
+            break if t1 >= deadline
+          end
+          { latencies: latencies, finished: now }
+        end
+      end
+
+      # All workers share one deadline, so the measured window is the same
+      # however the scheduler staggers their start
+      threads.times { ready.pop }
+      started = now
+      threads.times { start_gate << started + duration }
+      results = workers.map(&:value)
+      [results, results.map { |r| r[:finished] }.max - started]
+    end
+
+    # Same as measure, with one Ractor per worker instead of one thread
+    def self.measure_ractors(ractors, duration)
+      codes = WORKLOAD.map { |w| w[:code] }
+      workers = Array.new(ractors) do
+        Ractor.new(codes) do |workload|
+          clock = -> { Process.clock_gettime(Process::CLOCK_MONOTONIC) }
+          sandbox = MQuickJS::Sandbox.new(memory_limit: 1_000_000, timeout_ms: 10_000)
+          workload.each { |code| sandbox.eval(code) } # warmup
+          latencies = []
+
+          Ractor.yield :ready
+          deadline = Ractor.receive
+          i = 0
+          loop do
+            t0 = clock.call
+            sandbox.eval(workload[i % workload.size])
+            t1 = clock.call
+            latencies << (t1 - t0) * 1_000_000
+            i += 1
+            break if t1 >= deadline
+          end
+          { latencies: latencies, finished: clock.call }
+        end
+      end
+
+      workers.each(&:take)
+      started = now
+      workers.each { |worker| worker.send(started + duration) }
+      results = workers.map(&:take)
+      [results, results.map { |r| r[:finished] }.max - started]
+    end
+
+    def self.percentile(sorted, pct)
+      return 0.0 if sorted.empty?
+
+      sorted[((sorted.size - 1) * pct / 100.0).round]
+    end
+
+    def self.now
+      Process.clock_gettime(Process::CLOCK_MONOTONIC)
+    end
+  end
+end
+
+if __FILE__ == $0
+  Benchmarks::Concurrency.run
+end
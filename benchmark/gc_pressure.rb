@@ -0,0 +1,215 @@
+# frozen_string_literal: true
+
+require_relative '../lib/mquickjs'
+require_relative 'results'
+
+module Benchmarks
+  class GcPressure
+    # Live-heap ratios swept by the pause benchmark, as a share of memory_limit
+    LIVE_RATIOS = [0.10, 0.25, 0.50, 0.75, 0.90, 0.95].freeze
+
+    # Short-lived garbage made by one eval of the pause benchmark, small
+    # enough that most evals trigger at most one collection
+    CHURN = <<~JS
+      var t = 0;
+      for (var i = 0; i < 100; i++) { var o = { a: i, b: [i, i] }; t += o.b[1]; }
+      t
+    JS
+
+    # Allocation kinds for the allocation-rate benchmark; each makes
+    # ALLOCS_PER_EVAL short-lived values
+    ALLOCS_PER_EVAL = 1000
+    ALLOCATIONS = [
+      { name: "objects", code: "for (var i = 0; i < #{ALLOCS_PER_EVAL}; i++) { var o = { x: i, y: i }; }" },
+      { name: "arrays", code: "for (var i = 0; i < #{ALLOCS_PER_EVAL}; i++) { var a = [i, i, i]; }" },
+      { name: "strings", code: "for (var i = 0; i < #{ALLOCS_PER_EVAL}; i++) { var s = 'item-' + i; }" },
+      { name: "floats", code: "var f = 0.5; for (var i = 0; i < #{ALLOCS_PER_EVAL}; i++) { f = f * 1.000001 + 0.25; }" },
+      { name: "closures", code: "for (var i = 0; i < #{ALLOCS_PER_EVAL}; i++) { var c = function() { return i; }; }" }
+    ].freeze
+
+    ARRAY_LENGTHS = [1_000, 10_000, 100_000, 1_000_000].freeze
+
+    def self.run(duration: 1.0, memory_limit: 4 * 1024 * 1024)
+      puts "\n=== GC and Memory Pressure Benchmark ==="
+      puts "Duration: #{duration}s per case, pauses from Result#timings and MQuickJS.metrics"
+
+      live_heap(duration, memory_limit)
+      allocation_rate(duration, memory_limit)
+      array_growth
+      atom_growth
+    end
+
+    # Pause distribution and throughput of a fixed garbage workload while
+    # a growing share of the heap stays live
+    def self.live_heap(duration, memory_limit)
+      puts "\n  Live heap sweep (memory_limit: #{memory_limit / 1024} KB, 100 short-lived objects per eval):"
+      puts format("  %-6s %10s %9s %9s %11s %11s %11s %11s %8s",
+                  "Live", "Evals/s", "GCs", "GC/eval", "Pause p50", "Pause p99", "Pause max", "Hist p99", "GC %")
+
+      LIVE_RATIOS.each do |ratio|
+        sandbox = MQuickJS::Sandbox.new(memory_limit: memory_limit, timeout_ms: 60_000, timings: true)
+        live = fill(sandbox, (memory_limit * ratio).to_i)
+        MQuickJS.metrics.reset
+
+        evals = 0
+        gc_count = 0
+        gc_ms = 0.0
+        pauses = []
+        samples = []
+        start = now
+        begin
+          while now - start < duration
+            t0 = now
+            timings = sandbox.eval(CHURN).timings
+            samples << (now - t0) * 1_000_000
+            evals += 1
+            gc_count += timings[:gc_count]
+            gc_ms += timings[:gc_ms]
+            pauses << timings[:gc_max_ms] if timings[:gc_count].positive?
+          end
+        rescue MQuickJS::MemoryLimitError
+          puts format("  %5.0f%% out of memory after %d evals (live: %d KB)", ratio * 100, evals, live / 1024)
+          next
+        end
+        elapsed = now - start
+
+        pauses.sort!
+        histogram = MQuickJS.metrics.snapshot[:histograms][:gc_duration_seconds]
+        Results.add(suite: "gc_pressure", name: "live #{(ratio * 100).round}%", samples_us: samples, total_s: elapsed)
+
+        puts format("  %5.0f%% %10.0f %9d %9.2f %9.3fms %9.3fms %9.3fms %11s %7.1f%%",
+                    ratio * 100, evals / elapsed, gc_count, gc_count.fdiv(evals),
+                    percentile(pauses, 50), percentile(pauses, 99), pauses.last || 0.0,
+                    histogram_percentile(histogram, 99), gc_ms / (elapsed * 10))
+      end
+
+      puts "\n  Pause p50/p99/max: longest collection of each eval that collected (gc_max_ms)."
+      puts "  Hist p99: upper bound of the gc_duration_seconds bucket holding the 99th percentile pause."
+    end
+
+    # Throughput of short-lived allocations of each kind, and the share of
+    # time spent collecting them
+    def self.allocation_rate(duration, memory_limit)
+      puts "\n  Short-lived allocation rate (memory_limit: #{memory_limit / 1024} KB):"
+      puts format("  %-10s %14s %12s %10s %8s", "Kind", "Allocs/s", "ns/alloc", "GCs/M", "GC %")
+
+      ALLOCATIONS.each do |kind|
+        sandbox = MQuickJS::Sandbox.new(memory_limit: memory_limit, timeout_ms: 60_000, timings: true)
+        sandbox.eval(kind[:code])
+
+        evals = 0
+        gc_count = 0
+        gc_ms = 0.0
+        samples = []
+        start = now
+        while now - start < duration
+          t0 = now
+          timings = sandbox.eval(kind[:code]).timings
+          samples << (now - t0) * 1_000_000
+          evals += 1
+          gc_count += timings[:gc_count]
+          gc_ms += timings[:gc_ms]
+        end
+        elapsed = now - start
+        allocations = evals * ALLOCS_PER_EVAL
+        Results.add(suite: "gc_pressure", name: "allocate #{kind[:name]}", samples_us: samples, total_s: elapsed)
+
+        puts format("  %-10s %14.0f %12.1f %10.1f %7.1f%%",
+                    kind[:name], allocations / elapsed, elapsed * 1e9 / allocations,
+                    gc_count * 1e6 / allocations, gc_ms / (elapsed * 10))
+      end
+    end
+
+    # Cost of growing one array by push, including the copies of its
+    # backing store and the collections they trigger
+    def self.array_growth
+      puts "\n  Big array growth (push, memory_limit: 64 MB):"
+      puts format("  %-10s %10s %10s %6s %11s %12s", "Length", "Total", "ns/push", "GCs", "Pause max", "Peak heap")
+
+      ARRAY_LENGTHS.each do |length|
+        sandbox = MQuickJS::Sandbox.new(memory_limit: 64 * 1024 * 1024, timeout_ms: 60_000, timings: true)
+        sandbox.memory_usage(reset_peak: true)
+
+        result = Results.record("gc_pressure", "array push #{length}") do
+          sandbox.eval("var a = []; for (var i = 0; i < #{length}; i++) a.push(i); a.length")
+        end
+        timings = result.timings
+
+        puts format("  %-10d %8.2fms %10.1f %6d %9.3fms %9d KB",
+                    length, timings[:total_ms], timings[:total_ms] * 1e6 / length, timings[:gc_count],
+                    timings[:gc_max_ms], sandbox.memory_usage[:peak_heap_size] / 1024)
+      end
+    end
+
+    # Properties with dynamically built names intern a new atom per name.
+    # Each round adds ATOM_KEYS fresh keys to a throwaway object; the heap
+    # left after a full GC shows whether those atoms are ever reclaimed.
+    ATOM_KEYS = 2000
+    ATOM_ROUNDS = 8
+
+    def self.atom_growth
+      puts "\n  Atom table growth (#{ATOM_KEYS} new dynamic keys per round, memory_limit: 16 MB):"
+      puts format("  %-6s %12s %12s %16s", "Round", "Total", "ns/key", "Heap after GC")
+
+      sandbox = MQuickJS::Sandbox.new(memory_limit: 16 * 1024 * 1024, timeout_ms: 60_000, timings: true)
+      sandbox.eval("gc()")
+      baseline = sandbox.memory_usage[:heap_size]
+
+      ATOM_ROUNDS.times do |round|
+        code = <<~JS
+          var o = {};
+          for (var i = 0; i < #{ATOM_KEYS}; i++) o["k#{round}_" + i] = i;
+          o = null;
+        JS
+        result = Results.record("gc_pressure", "atoms round #{round + 1}") { sandbox.eval(code) }
+        sandbox.eval("gc()")
+
+        puts format("  %-6d %10.2fms %12.1f %13d KB",
+                    round + 1, result.timings[:total_ms], result.timings[:total_ms] * 1e6 / ATOM_KEYS,
+                    sandbox.memory_usage[:heap_size] / 1024)
+      end
+
+      retained = sandbox.memory_usage[:heap_size] - baseline
+      puts format("\n  Retained after %d rounds: %d KB (%.1f bytes per key)",
+                  ATOM_ROUNDS, retained / 1024, retained.fdiv(ATOM_KEYS * ATOM_ROUNDS))
+    end
+
+    # Keeps ~target_bytes of small objects reachable from the global `live`
+    # and returns the heap size after a full GC. The objects are kept in
+    # chunks of at most 500, so filling never copies a large array.
+    def self.fill(sandbox, target_bytes)
+      sandbox.eval("var live = []; gc()")
+      loop do
+        heap = sandbox.memory_usage[:heap_size]
+        return heap if heap >= target_bytes
+
+        batch = ((target_bytes - heap) / 128).clamp(1, 500)
+        sandbox.eval("var c = []; for (var i = 0; i < #{batch}; i++) c.push({ id: i, v: [i] }); live.push(c); c = null; gc()")
+      end
+    end
+
+    # Estimated percentile from cumulative histogram buckets: the upper
+    # bound of the first bucket holding pct% of the observations
+    def self.histogram_percentile(histogram, pct)
+      return "-" if histogram[:count].zero?
+
+      threshold = histogram[:count] * pct / 100.0
+      bound = histogram[:buckets].find { |_bound, count| count >= threshold }.first
+      bound.infinite? ? "+Inf" : format("<=%gms", bound * 1000)
+    end
+
+    def self.percentile(sorted, pct)
+      return 0.0 if sorted.empty?
+
+      sorted[((sorted.size - 1) * pct / 100.0).round]
+    end
+
+    def self.now
+      Process.clock_gettime(Process::CLOCK_MONOTONIC)
+    end
+  end
+end
+
+if __FILE__ == $0
+  Benchmarks::GcPressure.run
+end
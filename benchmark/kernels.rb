@@ -0,0 +1,75 @@
+# frozen_string_literal: true
+
+require_relative '../lib/mquickjs'
+require_relative 'results'
+
+module Benchmarks
+  class Kernels
+    KERNEL_DIR = File.join(__dir__, 'kernels')
+
+    # Classic JavaScript benchmark kernels. Each file defines run(), which
+    # performs one iteration and throws if its result is wrong.
+    #
+    # reference_ms is the time per run on the reference machine (Ruby 3.3,
+    # Linux x86_64). As in Octane, a kernel running at reference speed scores
+    # 100 and a kernel running twice as fast scores 200.
+    KERNELS = [
+      { name: "Richards", file: "richards.js", reference_ms: 4.4 },
+      { name: "DeltaBlue", file: "deltablue.js", reference_ms: 7.9 },
+      { name: "NavierStokes", file: "navier_stokes.js", reference_ms: 340.0 },
+      { name: "Crypto", file: "crypto.js", reference_ms: 55.0 },
+      { name: "RayTrace", file: "raytrace.js", reference_ms: 245.0 },
+      { name: "Splay", file: "splay.js", reference_ms: 3.4 },
+      { name: "JSON", file: "json.js", reference_ms: 7.3 }
+    ].freeze
+
+    def self.run(duration: 2.0, warmup: 3, filter: nil)
+      puts "\n=== Classic Kernels Benchmark ==="
+      puts "Minimum duration: #{duration}s per kernel, warmup: #{warmup} runs"
+
+      puts format("\n  %-14s %8s %12s %10s", "Kernel", "Runs", "ms/run", "Score")
+
+      scores = KERNELS.filter_map do |kernel|
+        next if filter && !kernel[:name].downcase.include?(filter.downcase)
+
+        runs, ms_per_run = measure(kernel, duration, warmup)
+        score = kernel[:reference_ms] / ms_per_run * 100
+        puts format("  %-14s %8d %12.2f %10.0f", kernel[:name], runs, ms_per_run, score)
+        score
+      end
+
+      return if scores.empty?
+
+      puts format("\n  %-14s %31.0f", "Score", geometric_mean(scores))
+    end
+
+    # Runs the kernel until it has taken at least `duration` seconds, and at
+    # least three times, in a sandbox of its own
+    def self.measure(kernel, duration, warmup)
+      sandbox = MQuickJS::Sandbox.new(memory_limit: 64 * 1024 * 1024, timeout_ms: 600_000)
+      sandbox.eval(File.read(File.join(KERNEL_DIR, kernel[:file])))
+      warmup.times { sandbox.eval("run()") }
+
+      runs = 0
+      start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+      elapsed = 0.0
+      Results.record("kernels", kernel[:name]) do
+        while elapsed < duration || runs < 3
+          sandbox.eval("run()")
+          runs += 1
+          elapsed = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+        end
+      end
+
+      [runs, elapsed * 1000 / runs]
+    end
+
+    def self.geometric_mean(values)
+      Math.exp(values.sum { |value| Math.log(value) } / values.size)
+    end
+  end
+end
+
+if __FILE__ == $0
+  Benchmarks::Kernels.run(filter: ARGV[0])
+end
@@ -0,0 +1,325 @@
+// Crypto: RSA encryption and decryption
+//
+// Big-integer RSA in the spirit of the Octane Crypto benchmark (Tom Wu's
+// jsbn), reduced to the operations RSA needs. Numbers are little-endian
+// arrays of 14-bit digits so every partial product stays a small integer.
+// Exercises integer arithmetic, bit operations and tight array loops.
+
+var DB = 14;
+var DM = (1 << DB) - 1;
+var DV = 1 << DB;
+
+// 256-bit primes; n = p * q is a 512-bit modulus
+var P_HEX = "f605d4251650de89d66b597adcbc78bc683a8581d2f7b54cc06e92f6d9bf9587";
+var Q_HEX = "e7d19836a1ac861521a7388f6647d886595908c95fe05ab0ff5f7198be9b93c7";
+var E = 65537;
+var MESSAGE = "The quick brown fox jumped over the extremely lazy frog! Now is the time for all good men.";
+
+function bnClamp(a) {
+  while (a.length > 0 && a[a.length - 1] === 0) a.pop();
+  return a;
+}
+
+var HEX_DIGITS = "0123456789abcdef";
+
+function bnFromHex(hex) {
+  var r = [], acc = 0, bits = 0;
+  for (var i = hex.length - 1; i >= 0; i--) {
+    acc |= HEX_DIGITS.indexOf(hex.charAt(i)) << bits;
+    bits += 4;
+    if (bits >= DB) {
+      r.push(acc & DM);
+      acc >>= DB;
+      bits -= DB;
+    }
+  }
+  if (bits > 0) r.push(acc);
+  return bnClamp(r);
+}
+
+function bnFromBytes(bytes) {
+  var r = [], acc = 0, bits = 0;
+  for (var i = bytes.length - 1; i >= 0; i--) {
+    acc |= bytes[i] << bits;
+    bits += 8;
+    if (bits >= DB) {
+      r.push(acc & DM);
+      acc >>= DB;
+      bits -= DB;
+    }
+  }
+  if (bits > 0) r.push(acc);
+  return bnClamp(r);
+}
+
+function bnToBytes(a) {
+  var bytes = [], acc = 0, bits = 0;
+  for (var i = 0; i < a.length; i++) {
+    acc |= a[i] << bits;
+    bits += DB;
+    while (bits >= 8) {
+      bytes.push(acc & 0xff);
+      acc >>= 8;
+      bits -= 8;
+    }
+  }
+  if (bits > 0) bytes.push(acc);
+  while (bytes.length > 0 && bytes[bytes.length - 1] === 0) bytes.pop();
+  return bytes.reverse();
+}
+
+function bnCompare(a, b) {
+  if (a.length !== b.length) return a.length - b.length;
+  for (var i = a.length - 1; i >= 0; i--) {
+    if (a[i] !== b[i]) return a[i] - b[i];
+  }
+  return 0;
+}
+
+function bnAdd(a, b) {
+  var r = [], carry = 0, n = Math.max(a.length, b.length);
+  for (var i = 0; i < n; i++) {
+    var x = (i < a.length ? a[i] : 0) + (i < b.length ? b[i] : 0) + carry;
+    r.push(x & DM);
+    carry = x >> DB;
+  }
+  if (carry) r.push(carry);
+  return r;
+}
+
+// a - b, requires a >= b
+function bnSub(a, b) {
+  var r = [], borrow = 0;
+  for (var i = 0; i < a.length; i++) {
+    var x = a[i] - (i < b.length ? b[i] : 0) - borrow;
+    borrow = x < 0 ? 1 : 0;
+    r.push(x & DM);
+  }
+  return bnClamp(r);
+}
+
+function bnMul(a, b) {
+  var r = [], i, j;
+  for (i = 0; i < a.length + b.length; i++) r.push(0);
+  for (i = 0; i < a.length; i++) {
+    var carry = 0, ai = a[i];
+    for (j = 0; j < b.length; j++) {
+      var x = r[i + j] + ai * b[j] + carry;
+      r[i + j] = x & DM;
+      carry = x >> DB;
+    }
+    r[i + b.length] = carry;
+  }
+  return bnClamp(r);
+}
+
+function bnMulSmall(a, m) {
+  var r = [], carry = 0;
+  for (var i = 0; i < a.length; i++) {
+    var x = a[i] * m + carry;
+    r.push(x % DV);
+    carry = Math.floor(x / DV);
+  }
+  while (carry > 0) {
+    r.push(carry % DV);
+    carry = Math.floor(carry / DV);
+  }
+  return bnClamp(r);
+}
+
+function bnAddSmall(a, s) {
+  return bnAdd(a, bnFromInt(s));
+}
+
+function bnSubSmall(a, s) {
+  return bnSub(a, bnFromInt(s));
+}
+
+function bnDivSmall(a, m) {
+  var q = [], rem = 0;
+  for (var i = a.length - 1; i >= 0; i--) {
+    var x = rem * DV + a[i];
+    q.push(Math.floor(x / m));
+    rem = x % m;
+  }
+  return bnClamp(q.reverse());
+}
+
+function bnModSmall(a, m) {
+  var rem = 0;
+  for (var i = a.length - 1; i >= 0; i--) rem = (rem * DV + a[i]) % m;
+  return rem;
+}
+
+function bnFromInt(v) {
+  var r = [];
+  while (v > 0) {
+    r.push(v & DM);
+    v >>= DB;
+  }
+  return r;
+}
+
+function bnBitLength(a) {
+  if (a.length === 0) return 0;
+  var top = a[a.length - 1], bits = 0;
+  while (top > 0) {
+    bits++;
+    top >>= 1;
+  }
+  return (a.length - 1) * DB + bits;
+}
+
+function bnTestBit(a, n) {
+  var i = (n / DB) | 0;
+  return i < a.length && ((a[i] >> (n % DB)) & 1) === 1;
+}
+
+function bnShiftLeft1(a) {
+  var r = [], carry = 0;
+  for (var i = 0; i < a.length; i++) {
+    var x = (a[i] << 1) | carry;
+    r.push(x & DM);
+    carry = x >> DB;
+  }
+  if (carry) r.push(carry);
+  return r;
+}
+
+// Inverse of a modulo a small m, by the extended Euclidean algorithm
+function smallModInverse(a, m) {
+  var t = 0, newT = 1, r = m, newR = a % m;
+  while (newR !== 0) {
+    var q = Math.floor(r / newR), tmp = t - q * newT;
+    t = newT;
+    newT = tmp;
+    tmp = r - q * newR;
+    r = newR;
+    newR = tmp;
+  }
+  return t < 0 ? t + m : t;
+}
+
+// e^-1 mod m for a small prime e, as (1 + k * m) / e
+function bnInverseOfSmall(e, m) {
+  var k = (e - smallModInverse(bnModSmall(m, e), e)) % e;
+  return bnDivSmall(bnAddSmall(bnMulSmall(m, k), 1), e);
+}
+
+// Montgomery arithmetic modulo an odd m, with R = DV^len
+
+function Montgomery(m) {
+  this.m = m;
+  this.len = m.length;
+  var m0 = m[0], inv = m0;
+  for (var i = 0; i < 4; i++) inv = (inv * (2 - ((m0 * inv) & DM))) & DM;
+  this.mInv = (DV - inv) & DM;
+
+  var r = [1];
+  for (i = 0; i < 2 * DB * this.len; i++) {
+    r = bnShiftLeft1(r);
+    if (bnCompare(r, m) >= 0) r = bnSub(r, m);
+  }
+  this.r2 = r;
+  this.one = this.reduce([1], this.r2);
+}
+
+// a * b * R^-1 mod m, for a * b < m * R
+Montgomery.prototype.reduce = function(a, b) {
+  var len = this.len, m = this.m, mInv = this.mInv;
+  var t = [], i, j, size = Math.max(a.length + b.length, 2 * len) + 1;
+  for (i = 0; i < size; i++) t.push(0);
+  for (i = 0; i < a.length; i++) {
+    var carry = 0, ai = a[i];
+    for (j = 0; j < b.length; j++) {
+      var x = t[i + j] + ai * b[j] + carry;
+      t[i + j] = x & DM;
+      carry = x >> DB;
+    }
+    t[i + b.length] = carry;
+  }
+  for (i = 0; i < len; i++) {
+    var u = (t[i] * mInv) & DM;
+    carry = 0;
+    for (j = 0; j < len; j++) {
+      x = t[i + j] + u * m[j] + carry;
+      t[i + j] = x & DM;
+      carry = x >> DB;
+    }
+    for (j = i + len; carry !== 0; j++) {
+      x = t[j] + carry;
+      t[j] = x & DM;
+      carry = x >> DB;
+    }
+  }
+  var r = bnClamp(t.slice(len));
+  if (bnCompare(r, m) >= 0) r = bnSub(r, m);
+  return r;
+};
+
+// x mod m, for x < m * R
+Montgomery.prototype.mod = function(x) {
+  return this.reduce(this.reduce(x, [1]), this.r2);
+};
+
+Montgomery.prototype.pow = function(base, exp) {
+  var x = this.reduce(this.mod(base), this.r2);
+  var r = this.one;
+  for (var i = bnBitLength(exp) - 1; i >= 0; i--) {
+    r = this.reduce(r, r);
+    if (bnTestBit(exp, i)) r = this.reduce(r, x);
+  }
+  return this.reduce(r, [1]);
+};
+
+function RSAKey(pHex, qHex, e) {
+  this.p = bnFromHex(pHex);
+  this.q = bnFromHex(qHex);
+  this.n = bnMul(this.p, this.q);
+  this.e = bnFromInt(e);
+  var pm1 = bnSubSmall(this.p, 1), qm1 = bnSubSmall(this.q, 1);
+  this.dmp1 = bnInverseOfSmall(e, pm1);
+  this.dmq1 = bnInverseOfSmall(e, qm1);
+  this.montN = new Montgomery(this.n);
+  this.montP = new Montgomery(this.p);
+  this.montQ = new Montgomery(this.q);
+  // q^-1 mod p, by Fermat's little theorem
+  this.coeff = this.montP.pow(this.q, bnSubSmall(this.p, 2));
+}
+
+RSAKey.prototype.encrypt = function(m) {
+  return this.montN.pow(m, this.e);
+};
+
+// Chinese remainder theorem decryption
+RSAKey.prototype.decrypt = function(c) {
+  var m1 = this.montP.pow(c, this.dmp1);
+  var m2 = this.montQ.pow(c, this.dmq1);
+  var diff = bnSub(bnAdd(m1, this.p), this.montP.mod(m2));
+  var h = this.montP.mod(bnMul(this.coeff, this.montP.mod(diff)));
+  return bnAdd(m2, bnMul(h, this.q));
+};
+
+function stringToBytes(s) {
+  var bytes = [];
+  for (var i = 0; i < s.length; i++) bytes.push(s.charCodeAt(i) & 0xff);
+  return bytes;
+}
+
+function bytesToString(bytes) {
+  var s = "";
+  for (var i = 0; i < bytes.length; i++) s += String.fromCharCode(bytes[i]);
+  return s;
+}
+
+var key = new RSAKey(P_HEX, Q_HEX, E);
+var plainText = bnFromBytes(stringToBytes(MESSAGE.substring(0, 60)));
+
+function run() {
+  var cipherText = key.encrypt(plainText);
+  var decrypted = bytesToString(bnToBytes(key.decrypt(cipherText)));
+  if (decrypted !== MESSAGE.substring(0, 60)) {
+    throw new Error("Crypto: decryption mismatch: " + decrypted);
+  }
+  return cipherText.length;
+}
@@ -0,0 +1,86 @@
+// JSON: serialize, parse and walk API-shaped documents
+//
+// Models the most common sandbox workload: a script receives a JSON
+// payload, parses it, transforms the records and serializes a response.
+// Exercises JSON.parse/JSON.stringify, string building and allocation of
+// many small objects and arrays.
+
+var RECORD_COUNT = 200;
+var EXPECTED_REVENUE = 191010.76;
+
+var seed = 12345;
+
+// Park-Miller generator; products stay exact in doubles
+function random() {
+  seed = (seed * 16807) % 2147483647;
+  return seed / 2147483647;
+}
+
+var WORDS = ["alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel",
+             "india", "juliet", "kilo", "lima", "mike", "november", "oscar", "papa"];
+
+function word() {
+  return WORDS[(random() * WORDS.length) | 0];
+}
+
+function buildRecord(id) {
+  var tags = [];
+  var tagCount = 1 + ((random() * 4) | 0);
+  for (var i = 0; i < tagCount; i++) tags.push(word());
+  return {
+    id: id,
+    name: word() + " " + word(),
+    email: word() + "." + id + "@example.com",
+    active: random() > 0.3,
+    score: Math.round(random() * 10000) / 100,
+    tags: tags,
+    address: {
+      street: ((random() * 999) | 0) + " " + word() + " street",
+      city: word(),
+      zip: String(10000 + ((random() * 89999) | 0))
+    },
+    orders: [
+      { sku: "SKU-" + ((random() * 1e6) | 0), quantity: 1 + ((random() * 5) | 0), price: Math.round(random() * 50000) / 100 },
+      { sku: "SKU-" + ((random() * 1e6) | 0), quantity: 1 + ((random() * 5) | 0), price: Math.round(random() * 50000) / 100 }
+    ]
+  };
+}
+
+function buildDocument() {
+  var records = [];
+  for (var i = 0; i < RECORD_COUNT; i++) records.push(buildRecord(i));
+  return { version: 3, generated: "2024-01-01T00:00:00Z", records: records };
+}
+
+var payload = JSON.stringify(buildDocument());
+
+function summarize(doc) {
+  var byCity = {}, totals = [], revenue = 0;
+  for (var i = 0; i < doc.records.length; i++) {
+    var record = doc.records[i];
+    if (!record.active) continue;
+    var total = 0;
+    for (var j = 0; j < record.orders.length; j++) {
+      total += record.orders[j].quantity * record.orders[j].price;
+    }
+    revenue += total;
+    var city = record.address.city;
+    byCity[city] = (byCity[city] || 0) + 1;
+    totals.push({ id: record.id, name: record.name.toUpperCase(), total: Math.round(total * 100) / 100, tags: record.tags.join(",") });
+  }
+  totals.sort(function(a, b) { return b.total - a.total || a.id - b.id; });
+  return { revenue: Math.round(revenue * 100) / 100, cities: byCity, top: totals.slice(0, 20), count: totals.length };
+}
+
+var EXPECTED = JSON.stringify(summarize(JSON.parse(payload)));
+if (JSON.parse(EXPECTED).revenue !== EXPECTED_REVENUE) throw new Error("JSON: unexpected revenue");
+
+function run() {
+  var doc = JSON.parse(payload);
+  var response = JSON.stringify(summarize(doc));
+  var roundTrip = JSON.stringify(JSON.parse(JSON.stringify(doc, null, 2)));
+  if (response !== EXPECTED || roundTrip !== payload) {
+    throw new Error("JSON: output mismatch");
+  }
+  return response.length;
+}
@@ -0,0 +1,271 @@
+// NavierStokes: 2D fluid solver
+//
+// ES5 port of Oliver Hunt's port of Jos Stam's "Real-Time Fluid Dynamics
+// for Games" solver, after the version in the Octane suite. Exercises
+// floating-point arithmetic and indexed access on large numeric arrays.
+
+var GRID_SIZE = 64;
+var FRAMES = 10;
+
+function FluidField(width, height) {
+  this.width = width;
+  this.height = height;
+  this.rowSize = width + 2;
+  this.size = (width + 2) * (height + 2);
+  this.iterations = 20;
+  this.dt = 0.1;
+  this.dens = this.newArray();
+  this.densPrev = this.newArray();
+  this.u = this.newArray();
+  this.uPrev = this.newArray();
+  this.v = this.newArray();
+  this.vPrev = this.newArray();
+}
+
+FluidField.prototype.newArray = function() {
+  var a = [];
+  for (var i = 0; i < this.size; i++) a.push(0);
+  return a;
+};
+
+FluidField.prototype.addFields = function(x, s, dt) {
+  for (var i = 0; i < this.size; i++) x[i] += dt * s[i];
+};
+
+FluidField.prototype.setBoundary = function(b, x) {
+  var width = this.width, height = this.height, rowSize = this.rowSize;
+  var i, j;
+  if (b == 1) {
+    for (i = 1; i <= width; i++) {
+      x[i] = x[i + rowSize];
+      x[i + (height + 1) * rowSize] = x[i + height * rowSize];
+    }
+    for (j = 1; j <= height; j++) {
+      x[j * rowSize] = -x[1 + j * rowSize];
+      x[(width + 1) + j * rowSize] = -x[width + j * rowSize];
+    }
+  } else if (b == 2) {
+    for (i = 1; i <= width; i++) {
+      x[i] = -x[i + rowSize];
+      x[i + (height + 1) * rowSize] = -x[i + height * rowSize];
+    }
+    for (j = 1; j <= height; j++) {
+      x[j * rowSize] = x[1 + j * rowSize];
+      x[(width + 1) + j * rowSize] = x[width + j * rowSize];
+    }
+  } else {
+    for (i = 1; i <= width; i++) {
+      x[i] = x[i + rowSize];
+      x[i + (height + 1) * rowSize] = x[i + height * rowSize];
+    }
+    for (j = 1; j <= height; j++) {
+      x[j * rowSize] = x[1 + j * rowSize];
+      x[(width + 1) + j * rowSize] = x[width + j * rowSize];
+    }
+  }
+  var maxEdge = (height + 1) * rowSize;
+  x[0] = 0.5 * (x[1] + x[rowSize]);
+  x[maxEdge] = 0.5 * (x[1 + maxEdge] + x[height * rowSize]);
+  x[width + 1] = 0.5 * (x[width] + x[(width + 1) + rowSize]);
+  x[(width + 1) + maxEdge] = 0.5 * (x[width + maxEdge] + x[(width + 1) + height * rowSize]);
+};
+
+FluidField.prototype.linSolve = function(b, x, x0, a, c) {
+  var width = this.width, height = this.height, rowSize = this.rowSize;
+  var i, j, k;
+  if (a === 0 && c === 1) {
+    for (j = 1; j <= height; j++) {
+      var row = j * rowSize;
+      for (i = 1; i <= width; i++) x[row + i] = x0[row + i];
+    }
+    this.setBoundary(b, x);
+  } else {
+    var invC = 1 / c;
+    for (k = 0; k < this.iterations; k++) {
+      for (j = 1; j <= height; j++) {
+        var lastRow = (j - 1) * rowSize;
+        var currentRow = j * rowSize;
+        var nextRow = (j + 1) * rowSize;
+        var lastX = x[currentRow];
+        ++currentRow;
+        for (i = 1; i <= width; i++) {
+          lastX = x[currentRow] = (x0[currentRow] + a * (lastX + x[++currentRow] + x[++lastRow] + x[++nextRow])) * invC;
+        }
+      }
+      this.setBoundary(b, x);
+    }
+  }
+};
+
+FluidField.prototype.diffuse = function(b, x, x0, dt) {
+  var a = 0;
+  this.linSolve(b, x, x0, a, 1 + 4 * a);
+};
+
+FluidField.prototype.linSolve2 = function(x, x0, y, y0, a, c) {
+  var width = this.width, height = this.height, rowSize = this.rowSize;
+  var i, j, k;
+  if (a === 0 && c === 1) {
+    for (j = 1; j <= height; j++) {
+      var row = j * rowSize;
+      for (i = 1; i <= width; i++) {
+        x[row + i] = x0[row + i];
+        y[row + i] = y0[row + i];
+      }
+    }
+    this.setBoundary(1, x);
+    this.setBoundary(2, y);
+  } else {
+    var invC = 1 / c;
+    for (k = 0; k < this.iterations; k++) {
+      for (j = 1; j <= height; j++) {
+        var lastRow = (j - 1) * rowSize;
+        var currentRow = j * rowSize;
+        var nextRow = (j + 1) * rowSize;
+        var lastX = x[currentRow];
+        var lastY = y[currentRow];
+        ++currentRow;
+        for (i = 1; i <= width; i++) {
+          lastX = x[currentRow] = (x0[currentRow] + a * (lastX + x[currentRow] + x[lastRow] + x[nextRow])) * invC;
+          lastY = y[currentRow] = (y0[currentRow] + a * (lastY + y[++currentRow] + y[++lastRow] + y[++nextRow])) * invC;
+        }
+      }
+      this.setBoundary(1, x);
+      this.setBoundary(2, y);
+    }
+  }
+};
+
+FluidField.prototype.diffuse2 = function(x, x0, y, y0, dt) {
+  var a = 0;
+  this.linSolve2(x, x0, y, y0, a, 1 + 4 * a);
+};
+
+FluidField.prototype.advect = function(b, d, d0, u, v, dt) {
+  var width = this.width, height = this.height, rowSize = this.rowSize;
+  var wdt0 = dt * width;
+  var hdt0 = dt * height;
+  var wp5 = width + 0.5;
+  var hp5 = height + 0.5;
+  for (var j = 1; j <= height; j++) {
+    var pos = j * rowSize;
+    for (var i = 1; i <= width; i++) {
+      var x = i - wdt0 * u[++pos];
+      var y = j - hdt0 * v[pos];
+      if (x < 0.5) x = 0.5;
+      else if (x > wp5) x = wp5;
+      var i0 = x | 0;
+      var i1 = i0 + 1;
+      if (y < 0.5) y = 0.5;
+      else if (y > hp5) y = hp5;
+      var j0 = y | 0;
+      var j1 = j0 + 1;
+      var s1 = x - i0;
+      var s0 = 1 - s1;
+      var t1 = y - j0;
+      var t0 = 1 - t1;
+      var row1 = j0 * rowSize;
+      var row2 = j1 * rowSize;
+      d[pos] = s0 * (t0 * d0[i0 + row1] + t1 * d0[i0 + row2]) +
+               s1 * (t0 * d0[i1 + row1] + t1 * d0[i1 + row2]);
+    }
+  }
+  this.setBoundary(b, d);
+};
+
+FluidField.prototype.project = function(u, v, p, div) {
+  var width = this.width, height = this.height, rowSize = this.rowSize;
+  var h = -0.5 / Math.sqrt(width * height);
+  var i, j;
+  for (j = 1; j <= height; j++) {
+    var row = j * rowSize;
+    var previousRow = (j - 1) * rowSize;
+    var prevValue = row - 1;
+    var currentRow = row;
+    var nextValue = row + 1;
+    var nextRow = (j + 1) * rowSize;
+    for (i = 1; i <= width; i++) {
+      div[++currentRow] = h * (u[++nextValue] - u[++prevValue] + v[++nextRow] - v[++previousRow]);
+      p[currentRow] = 0;
+    }
+  }
+  this.setBoundary(0, div);
+  this.setBoundary(0, p);
+
+  this.linSolve(0, p, div, 1, 4);
+  var wScale = 0.5 * width;
+  var hScale = 0.5 * height;
+  for (j = 1; j <= height; j++) {
+    var prevPos = j * rowSize - 1;
+    var currentPos = j * rowSize;
+    var nextPos = j * rowSize + 1;
+    var prevRow = (j - 1) * rowSize;
+    var nextRow2 = (j + 1) * rowSize;
+    for (i = 1; i <= width; i++) {
+      u[++currentPos] -= wScale * (p[++nextPos] - p[++prevPos]);
+      v[currentPos] -= hScale * (p[++nextRow2] - p[++prevRow]);
+    }
+  }
+  this.setBoundary(1, u);
+  this.setBoundary(2, v);
+};
+
+FluidField.prototype.densStep = function(x, x0, u, v, dt) {
+  this.addFields(x, x0, dt);
+  this.diffuse(0, x0, x, dt);
+  this.advect(0, x, x0, u, v, dt);
+};
+
+FluidField.prototype.velStep = function(u, v, u0, v0, dt) {
+  this.addFields(u, u0, dt);
+  this.addFields(v, v0, dt);
+  var temp = u0; u0 = u; u = temp;
+  temp = v0; v0 = v; v = temp;
+  this.diffuse2(u, u0, v, v0, dt);
+  this.project(u, v, u0, v0);
+  temp = u0; u0 = u; u = temp;
+  temp = v0; v0 = v; v = temp;
+  this.advect(1, u, u0, u0, v0, dt);
+  this.advect(2, v, v0, u0, v0, dt);
+  this.project(u, v, u0, v0);
+};
+
+// Seed density and velocity sources, as the UI callback in the original
+FluidField.prototype.addSources = function(frame) {
+  var rowSize = this.rowSize;
+  for (var i = 0; i < this.size; i++) {
+    this.uPrev[i] = this.vPrev[i] = this.densPrev[i] = 0;
+  }
+  if (frame < 5) {
+    var center = (this.width >> 1) + 1 + ((this.height >> 1) + 1) * rowSize;
+    this.densPrev[center] = 5000;
+  }
+  for (var x = 1; x <= this.width; x++) {
+    for (var y = 1; y <= this.height; y++) {
+      var pos = x + y * rowSize;
+      this.uPrev[pos] = (x - this.width / 2) * (y - this.height / 2) / 1000;
+      this.vPrev[pos] = this.uPrev[pos];
+    }
+  }
+};
+
+FluidField.prototype.update = function(frame) {
+  this.addSources(frame);
+  this.velStep(this.u, this.v, this.uPrev, this.vPrev, this.dt);
+  this.densStep(this.dens, this.densPrev, this.u, this.v, this.dt);
+};
+
+var EXPECTED_CHECKSUM = 27073;
+
+function run() {
+  var field = new FluidField(GRID_SIZE, GRID_SIZE);
+  for (var frame = 0; frame < FRAMES; frame++) field.update(frame);
+
+  var sum = 0;
+  for (var i = 0; i < field.size; i++) sum += field.dens[i] * 10 | 0;
+
+  if (sum !== EXPECTED_CHECKSUM) {
+    throw new Error("NavierStokes: checksum " + sum + ", expected " + EXPECTED_CHECKSUM);
+  }
+  return sum;
+}
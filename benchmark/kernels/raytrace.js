@@ -0,0 +1,380 @@
+// RayTrace: recursive ray tracer
+//
+// ES5 port in the style of Adam Burmister's Flog.RayTracer used by the V8
+// and Octane suites: spheres and a checkered plane lit by two lights, with
+// reflections and shadows. Exercises object allocation (vectors, colors,
+// rays), floating-point math and polymorphic intersection calls.
+
+var WIDTH = 50;
+var HEIGHT = 50;
+var TRACE_DEPTH = 2;
+
+function Vector(x, y, z) {
+  this.x = x;
+  this.y = y;
+  this.z = z;
+}
+
+Vector.prototype.normalize = function() {
+  var m = this.magnitude();
+  return new Vector(this.x / m, this.y / m, this.z / m);
+};
+
+Vector.prototype.magnitude = function() {
+  return Math.sqrt(this.x * this.x + this.y * this.y + this.z * this.z);
+};
+
+Vector.prototype.cross = function(w) {
+  return new Vector(-this.z * w.y + this.y * w.z, this.z * w.x - this.x * w.z, -this.y * w.x + this.x * w.y);
+};
+
+Vector.prototype.dot = function(w) {
+  return this.x * w.x + this.y * w.y + this.z * w.z;
+};
+
+Vector.add = function(v, w) {
+  return new Vector(w.x + v.x, w.y + v.y, w.z + v.z);
+};
+
+Vector.subtract = function(v, w) {
+  return new Vector(v.x - w.x, v.y - w.y, v.z - w.z);
+};
+
+Vector.multiplyScalar = function(v, w) {
+  return new Vector(v.x * w, v.y * w, v.z * w);
+};
+
+function Color(r, g, b) {
+  this.red = r;
+  this.green = g;
+  this.blue = b;
+}
+
+Color.add = function(c1, c2) {
+  return new Color(c1.red + c2.red, c1.green + c2.green, c1.blue + c2.blue);
+};
+
+Color.addScalar = function(c1, s) {
+  var result = new Color(c1.red + s, c1.green + s, c1.blue + s);
+  result.limit();
+  return result;
+};
+
+Color.multiply = function(c1, c2) {
+  return new Color(c1.red * c2.red, c1.green * c2.green, c1.blue * c2.blue);
+};
+
+Color.multiplyScalar = function(c1, f) {
+  return new Color(c1.red * f, c1.green * f, c1.blue * f);
+};
+
+Color.blend = function(c1, c2, w) {
+  return Color.add(Color.multiplyScalar(c1, 1 - w), Color.multiplyScalar(c2, w));
+};
+
+Color.prototype.limit = function() {
+  this.red = this.red > 0 ? (this.red > 1 ? 1 : this.red) : 0;
+  this.green = this.green > 0 ? (this.green > 1 ? 1 : this.green) : 0;
+  this.blue = this.blue > 0 ? (this.blue > 1 ? 1 : this.blue) : 0;
+};
+
+Color.prototype.brightness = function() {
+  var r = Math.floor(this.red * 255);
+  var g = Math.floor(this.green * 255);
+  var b = Math.floor(this.blue * 255);
+  return (r * 77 + g * 150 + b * 29) >> 8;
+};
+
+function Light(position, color, intensity) {
+  this.position = position;
+  this.color = color;
+  this.intensity = intensity || 10;
+}
+
+function Ray(position, direction) {
+  this.position = position;
+  this.direction = direction;
+}
+
+function IntersectionInfo() {
+  this.isHit = false;
+  this.hitCount = 0;
+  this.shape = null;
+  this.position = null;
+  this.normal = null;
+  this.color = null;
+  this.distance = null;
+}
+
+// Materials
+
+function Solid(color, reflection, refraction, transparency, gloss) {
+  this.color = color;
+  this.reflection = reflection;
+  this.refraction = refraction;
+  this.transparency = transparency;
+  this.gloss = gloss;
+  this.hasTexture = false;
+}
+
+Solid.prototype.getColor = function(u, v) {
+  return this.color;
+};
+
+function Chessboard(colorEven, colorOdd, reflection, transparency, gloss, density) {
+  this.colorEven = colorEven;
+  this.colorOdd = colorOdd;
+  this.reflection = reflection;
+  this.transparency = transparency;
+  this.gloss = gloss;
+  this.density = density;
+  this.hasTexture = true;
+}
+
+Chessboard.prototype.wrapUp = function(t) {
+  t = t % 2;
+  if (t < -1) t += 2;
+  if (t >= 1) t -= 2;
+  return t;
+};
+
+Chessboard.prototype.getColor = function(u, v) {
+  var t = this.wrapUp(u * this.density) * this.wrapUp(v * this.density);
+  return t < 0 ? this.colorEven : this.colorOdd;
+};
+
+// Shapes
+
+function Sphere(position, radius, material) {
+  this.radius = radius;
+  this.position = position;
+  this.material = material;
+}
+
+Sphere.prototype.intersect = function(ray) {
+  var info = new IntersectionInfo();
+  info.shape = this;
+
+  var dst = Vector.subtract(ray.position, this.position);
+  var B = dst.dot(ray.direction);
+  var C = dst.dot(dst) - (this.radius * this.radius);
+  var D = (B * B) - C;
+
+  if (D > 0) {
+    info.isHit = true;
+    info.distance = (-B) - Math.sqrt(D);
+    info.position = Vector.add(ray.position, Vector.multiplyScalar(ray.direction, info.distance));
+    info.normal = Vector.subtract(info.position, this.position).normalize();
+    info.color = this.material.getColor(0, 0);
+  } else {
+    info.isHit = false;
+  }
+  return info;
+};
+
+function Plane(position, d, material) {
+  this.position = position;
+  this.d = d;
+  this.material = material;
+}
+
+Plane.prototype.intersect = function(ray) {
+  var info = new IntersectionInfo();
+
+  var Vd = this.position.dot(ray.direction);
+  if (Vd == 0) return info;
+
+  var t = -(this.position.dot(ray.position) + this.d) / Vd;
+  if (t <= 0) return info;
+
+  info.shape = this;
+  info.isHit = true;
+  info.position = Vector.add(ray.position, Vector.multiplyScalar(ray.direction, t));
+  info.normal = this.position;
+  info.distance = t;
+
+  if (this.material.hasTexture) {
+    var vU = new Vector(this.position.y, this.position.z, -this.position.x);
+    var vV = vU.cross(this.position);
+    var u = info.position.dot(vU);
+    var v = info.position.dot(vV);
+    info.color = this.material.getColor(u, v);
+  } else {
+    info.color = this.material.getColor(0, 0);
+  }
+  return info;
+};
+
+// Scene and camera
+
+function Camera(position, lookAt, up) {
+  this.position = position;
+  this.lookAt = lookAt;
+  this.up = up;
+  this.equator = lookAt.normalize().cross(this.up);
+  this.screen = Vector.add(this.position, this.lookAt);
+}
+
+Camera.prototype.getRay = function(vx, vy) {
+  var pos = Vector.subtract(
+    this.screen,
+    Vector.subtract(Vector.multiplyScalar(this.equator, vx), Vector.multiplyScalar(this.up, vy))
+  );
+  pos.y = pos.y * -1;
+  var dir = Vector.subtract(pos, this.position);
+  return new Ray(pos, dir.normalize());
+};
+
+function Background(color, ambience) {
+  this.color = color;
+  this.ambience = ambience;
+}
+
+function Scene() {
+  this.camera = new Camera(new Vector(0, 0, -15), new Vector(-0.2, 0, 5), new Vector(0, 1, 0));
+  this.shapes = [];
+  this.lights = [];
+  this.background = new Background(new Color(0, 0, 0.5), 0.2);
+}
+
+// Engine
+
+function Engine(options) {
+  this.options = options;
+  this.options.canvasHeight /= this.options.pixelHeight;
+  this.options.canvasWidth /= this.options.pixelWidth;
+  this.checksum = 0;
+}
+
+Engine.prototype.renderScene = function(scene) {
+  this.checksum = 0;
+  var canvasHeight = this.options.canvasHeight;
+  var canvasWidth = this.options.canvasWidth;
+
+  for (var y = 0; y < canvasHeight; y++) {
+    for (var x = 0; x < canvasWidth; x++) {
+      var yp = y * 1 / canvasHeight * 2 - 1;
+      var xp = x * 1 / canvasWidth * 2 - 1;
+      var ray = scene.camera.getRay(xp, yp);
+      var color = this.getPixelColor(ray, scene);
+      this.checksum = (this.checksum * 31 + color.brightness()) % 1000000007;
+    }
+  }
+};
+
+Engine.prototype.getPixelColor = function(ray, scene) {
+  var info = this.testIntersection(ray, scene, null);
+  if (info.isHit) return this.rayTrace(info, ray, scene, 0);
+  return scene.background.color;
+};
+
+Engine.prototype.testIntersection = function(ray, scene, exclude) {
+  var hits = 0;
+  var best = new IntersectionInfo();
+  best.distance = 2000;
+
+  for (var i = 0; i < scene.shapes.length; i++) {
+    var shape = scene.shapes[i];
+    if (shape != exclude) {
+      var info = shape.intersect(ray);
+      if (info.isHit && info.distance >= 0 && info.distance < best.distance) {
+        best = info;
+        hits++;
+      }
+    }
+  }
+  best.hitCount = hits;
+  return best;
+};
+
+Engine.prototype.getReflectionRay = function(P, N, V) {
+  var c1 = -N.dot(V);
+  var R1 = Vector.add(Vector.multiplyScalar(N, 2 * c1), V);
+  return new Ray(P, R1);
+};
+
+Engine.prototype.rayTrace = function(info, ray, scene, depth) {
+  var color = Color.multiplyScalar(info.color, scene.background.ambience);
+  var shininess = Math.pow(10, info.shape.material.gloss + 1);
+
+  for (var i = 0; i < scene.lights.length; i++) {
+    var light = scene.lights[i];
+    var v = Vector.subtract(light.position, info.position).normalize();
+
+    if (this.options.renderDiffuse) {
+      var L = v.dot(info.normal);
+      if (L > 0) color = Color.add(color, Color.multiply(info.color, Color.multiplyScalar(light.color, L)));
+    }
+
+    if (depth <= this.options.rayDepth) {
+      if (this.options.renderReflections && info.shape.material.reflection > 0) {
+        var reflectionRay = this.getReflectionRay(info.position, info.normal, ray.direction);
+        var refl = this.testIntersection(reflectionRay, scene, info.shape);
+        if (refl.isHit && refl.distance > 0) {
+          refl.color = this.rayTrace(refl, reflectionRay, scene, depth + 1);
+        } else {
+          refl.color = scene.background.color;
+        }
+        color = Color.blend(color, refl.color, info.shape.material.reflection);
+      }
+    }
+
+    var shadowInfo = new IntersectionInfo();
+    if (this.options.renderShadows) {
+      var shadowRay = new Ray(info.position, v);
+      shadowInfo = this.testIntersection(shadowRay, scene, info.shape);
+      if (shadowInfo.isHit && shadowInfo.shape != info.shape) {
+        var vA = Color.multiplyScalar(color, 0.5);
+        var dB = (0.5 * Math.pow(shadowInfo.shape.material.transparency, 0.5));
+        color = Color.addScalar(vA, dB);
+      }
+    }
+
+    if (this.options.renderHighlights && !shadowInfo.isHit && info.shape.material.gloss > 0) {
+      var Lv = Vector.subtract(info.shape.position, light.position).normalize();
+      var E = Vector.subtract(scene.camera.position, info.shape.position).normalize();
+      var H = Vector.subtract(E, Lv).normalize();
+      var glossWeight = Math.pow(Math.max(info.normal.dot(H), 0), shininess);
+      color = Color.add(Color.multiplyScalar(light.color, glossWeight), color);
+    }
+  }
+  color.limit();
+  return color;
+};
+
+function buildScene() {
+  var scene = new Scene();
+
+  scene.shapes.push(new Sphere(new Vector(-1.5, 1.5, 2), 1.5,
+    new Solid(new Color(0, 0.5, 0.5), 0.3, 0.0, 0.0, 2.0)));
+  scene.shapes.push(new Sphere(new Vector(1, 0.25, 1), 0.5,
+    new Solid(new Color(0.9, 0.9, 0.9), 0.1, 0.0, 0.0, 1.5)));
+  scene.shapes.push(new Plane(new Vector(0.1, 0.9, -0.5).normalize(), 1.2,
+    new Chessboard(new Color(1, 1, 1), new Color(0, 0, 0), 0.2, 0.0, 1.0, 0.7)));
+
+  scene.lights.push(new Light(new Vector(5, 10, -1), new Color(0.8, 0.8, 0.8)));
+  scene.lights.push(new Light(new Vector(-3, 5, -15), new Color(0.8, 0.8, 0.8), 100));
+  return scene;
+}
+
+var EXPECTED_CHECKSUM = 864507382;
+
+function run() {
+  var engine = new Engine({
+    canvasWidth: WIDTH,
+    canvasHeight: HEIGHT,
+    pixelWidth: 1,
+    pixelHeight: 1,
+    renderDiffuse: true,
+    renderHighlights: true,
+    renderShadows: true,
+    renderReflections: true,
+    rayDepth: TRACE_DEPTH
+  });
+  engine.renderScene(buildScene());
+
+  if (engine.checksum !== EXPECTED_CHECKSUM) {
+    throw new Error("RayTrace: checksum " + engine.checksum + ", expected " + EXPECTED_CHECKSUM);
+  }
+  return engine.checksum;
+}
@@ -0,0 +1,211 @@
+// Splay: splay tree manipulation under GC pressure
+//
+// ES5 port of the Splay benchmark from the V8 and Octane suites. A large
+// splay tree whose nodes carry payload trees is kept live while every run
+// inserts and removes nodes, so most of the time goes to allocation and to
+// collecting a heap with many long-lived objects. The tree is smaller than
+// in Octane so it fits the default benchmark sandbox.
+
+var TREE_SIZE = 2000;
+var TREE_MODIFICATIONS = 80;
+var TREE_PAYLOAD_DEPTH = 4;
+
+var seed = 49734321;
+
+// Deterministic replacement for Math.random, as in the original
+function random() {
+  seed = ((seed + 0x7ed55d16) + (seed << 12)) & 0xffffffff;
+  seed = ((seed ^ 0xc761c23c) ^ (seed >>> 19)) & 0xffffffff;
+  seed = ((seed + 0x165667b1) + (seed << 5)) & 0xffffffff;
+  seed = ((seed + 0xd3a2646c) ^ (seed << 9)) & 0xffffffff;
+  seed = ((seed + 0xfd7046c5) + (seed << 3)) & 0xffffffff;
+  seed = ((seed ^ 0xb55a4f09) ^ (seed >>> 16)) & 0xffffffff;
+  return (seed & 0xfffffff) / 0x10000000;
+}
+
+function SplayTree() {
+  this.root = null;
+}
+
+SplayTree.prototype.isEmpty = function() {
+  return !this.root;
+};
+
+SplayTree.prototype.insert = function(key, value) {
+  if (this.isEmpty()) {
+    this.root = new SplayNode(key, value);
+    return;
+  }
+  this.splay(key);
+  if (this.root.key == key) return;
+  var node = new SplayNode(key, value);
+  if (key > this.root.key) {
+    node.left = this.root;
+    node.right = this.root.right;
+    this.root.right = null;
+  } else {
+    node.right = this.root;
+    node.left = this.root.left;
+    this.root.left = null;
+  }
+  this.root = node;
+};
+
+SplayTree.prototype.remove = function(key) {
+  if (this.isEmpty()) throw new Error("Key not found: " + key);
+  this.splay(key);
+  if (this.root.key != key) throw new Error("Key not found: " + key);
+  var removed = this.root;
+  if (!this.root.left) {
+    this.root = this.root.right;
+  } else {
+    var right = this.root.right;
+    this.root = this.root.left;
+    this.splay(key);
+    this.root.right = right;
+  }
+  return removed;
+};
+
+SplayTree.prototype.find = function(key) {
+  if (this.isEmpty()) return null;
+  this.splay(key);
+  return this.root.key == key ? this.root : null;
+};
+
+SplayTree.prototype.findMax = function(startNode) {
+  if (this.isEmpty()) return null;
+  var current = startNode || this.root;
+  while (current.right) current = current.right;
+  return current;
+};
+
+SplayTree.prototype.findGreatestLessThan = function(key) {
+  if (this.isEmpty()) return null;
+  this.splay(key);
+  if (this.root.key < key) {
+    return this.root;
+  } else if (this.root.left) {
+    return this.findMax(this.root.left);
+  } else {
+    return null;
+  }
+};
+
+SplayTree.prototype.exportKeys = function() {
+  var result = [];
+  if (!this.isEmpty()) {
+    this.root.traverse(function(node) { result.push(node.key); });
+  }
+  return result;
+};
+
+// Top-down splay, as in Sleator and Tarjan
+SplayTree.prototype.splay = function(key) {
+  if (this.isEmpty()) return;
+  var dummy, left, right;
+  dummy = left = right = new SplayNode(null, null);
+  var current = this.root;
+  while (true) {
+    if (key < current.key) {
+      if (!current.left) break;
+      if (key < current.left.key) {
+        var tmp = current.left;
+        current.left = tmp.right;
+        tmp.right = current;
+        current = tmp;
+        if (!current.left) break;
+      }
+      right.left = current;
+      right = current;
+      current = current.left;
+    } else if (key > current.key) {
+      if (!current.right) break;
+      if (key > current.right.key) {
+        tmp = current.right;
+        current.right = tmp.left;
+        tmp.left = current;
+        current = tmp;
+        if (!current.right) break;
+      }
+      left.right = current;
+      left = current;
+      current = current.right;
+    } else {
+      break;
+    }
+  }
+  left.right = current.left;
+  right.left = current.right;
+  current.left = dummy.right;
+  current.right = dummy.left;
+  this.root = current;
+};
+
+function SplayNode(key, value) {
+  this.key = key;
+  this.value = value;
+  this.left = null;
+  this.right = null;
+}
+
+SplayNode.prototype.traverse = function(f) {
+  var current = this;
+  while (current) {
+    var left = current.left;
+    if (left) left.traverse(f);
+    f(current);
+    current = current.right;
+  }
+};
+
+function generatePayloadTree(depth, tag) {
+  if (depth == 0) {
+    return {
+      array: [0, 1, 2, 3, 4, 5, 6, 7, 8, 9],
+      string: "String for key " + tag + " in leaf node"
+    };
+  } else {
+    return {
+      left: generatePayloadTree(depth - 1, tag),
+      right: generatePayloadTree(depth - 1, tag)
+    };
+  }
+}
+
+function generateKey() {
+  return random();
+}
+
+function insertNewNode() {
+  var key;
+  do {
+    key = generateKey();
+  } while (splayTree.find(key) != null);
+  var payload = generatePayloadTree(TREE_PAYLOAD_DEPTH, String(key));
+  splayTree.insert(key, payload);
+  return key;
+}
+
+var splayTree = new SplayTree();
+for (var i = 0; i < TREE_SIZE; i++) insertNewNode();
+
+function verify() {
+  var keys = splayTree.exportKeys();
+  if (keys.length != TREE_SIZE) throw new Error("Splay tree has wrong size: " + keys.length);
+  for (var i = 0; i < keys.length - 1; i++) {
+    if (keys[i] >= keys[i + 1]) throw new Error("Splay tree not sorted");
+  }
+}
+
+function run() {
+  // Replace a few nodes in the tree, making the old payloads garbage
+  for (var i = 0; i < TREE_MODIFICATIONS; i++) {
+    var key = insertNewNode();
+    var greatest = splayTree.findGreatestLessThan(key);
+    if (greatest == null) splayTree.remove(key);
+    else splayTree.remove(greatest.key);
+  }
+  verify();
+  return TREE_SIZE;
+}
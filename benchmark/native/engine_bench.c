@@ -0,0 +1,303 @@
+/*
+ * Engine micro-benchmarks without the Ruby extension
+ *
+ * Links directly against the MicroQuickJS sources in ext/mquickjs and the
+ * same generated stdlib as the gem, so the numbers measure the interpreter,
+ * the allocator and the GC only: no rb_funcall, Result allocation or value
+ * conversion. Build and run with `rake benchmark:native`.
+ *
+ * Each kernel defines bench(n), which performs the measured operation n
+ * times. The driver calibrates n so one run lasts about --target-ms, runs
+ * --warmup untimed iterations and then --reps timed ones, and reports
+ * nanoseconds per operation.
+ *
+ * usage: engine_bench [-r reps] [-w warmup] [-t target_ms] [-m memory_mb]
+ *                     [-l] [name-filter...]
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "mquickjs.h"
+
+static JSValue js_print(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
+static JSValue js_gc(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
+static JSValue js_date_now(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
+static JSValue js_performance_now(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
+static JSValue js_load(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
+static JSValue js_setTimeout(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
+static JSValue js_clearTimeout(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
+static JSValue js_fetch(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
+static JSValue js_sandbox_math_random(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
+
+// Same standard library as the gem
+#include "mqjs_stdlib.h"
+
+typedef struct {
+    const char *name;
+    const char *source;  // Must define bench(n)
+} Kernel;
+
+static const Kernel kernels[] = {
+    { "empty_loop",
+      "function bench(n) { for (var i = 0; i < n; i++) {} }" },
+    { "property_get",
+      "var o = { a: 1, b: 2, c: 3, d: 4 };"
+      "function bench(n) { var s = 0; for (var i = 0; i < n; i++) s += o.c; return s; }" },
+    { "property_set",
+      "var o = { a: 1, b: 2, c: 3, d: 4 };"
+      "function bench(n) { for (var i = 0; i < n; i++) o.d = i; }" },
+    { "property_get_proto",
+      "function P() {} P.prototype.m = 7; var o = new P();"
+      "function bench(n) { var s = 0; for (var i = 0; i < n; i++) s += o.m; return s; }" },
+    { "call",
+      "function f(a, b) { return a + b; }"
+      "function bench(n) { var s = 0; for (var i = 0; i < n; i++) s = f(s, 1); return s; }" },
+    { "method_call",
+      "var o = { k: 1, m: function(a) { return a + this.k; } };"
+      "function bench(n) { var s = 0; for (var i = 0; i < n; i++) s = o.m(s); return s; }" },
+    { "closure_create",
+      "function bench(n) { var f; for (var i = 0; i < n; i++) f = function() { return i; }; return f; }" },
+    { "closure_call",
+      "function make() { var c = 0; return function() { return ++c; }; }"
+      "var inc = make();"
+      "function bench(n) { var s = 0; for (var i = 0; i < n; i++) s = inc(); return s; }" },
+    { "string_concat",
+      "function bench(n) { var s = ''; for (var i = 0; i < n; i++) { s += 'x'; if (s.length > 1024) s = ''; } return s; }" },
+    { "string_join",
+      "var parts = []; for (var i = 0; i < 16; i++) parts.push('part' + i);"
+      "function bench(n) { var s; for (var i = 0; i < n; i++) s = parts.join(','); return s; }" },
+    { "json_parse",
+      "var text = JSON.stringify({ id: 42, name: 'widget', tags: ['a', 'b', 'c'], price: 9.99, nested: { ok: true } });"
+      "function bench(n) { var v; for (var i = 0; i < n; i++) v = JSON.parse(text); return v; }" },
+    { "json_stringify",
+      "var value = { id: 42, name: 'widget', tags: ['a', 'b', 'c'], price: 9.99, nested: { ok: true } };"
+      "function bench(n) { var s; for (var i = 0; i < n; i++) s = JSON.stringify(value); return s; }" },
+    { "regex_test",
+      "var re = /([a-z]+)@([a-z]+)\\.com/;"
+      "function bench(n) { var c = 0; for (var i = 0; i < n; i++) if (re.test('mail alice@example.com now')) c++; return c; }" },
+    { "regex_replace",
+      "var re = /o/g;"
+      "function bench(n) { var s; for (var i = 0; i < n; i++) s = 'foo boo zoo'.replace(re, '0'); return s; }" },
+    { "array_push_pop",
+      "var a = [];"
+      "function bench(n) { for (var i = 0; i < n; i++) { a.push(i); if (a.length > 64) a.length = 0; } }" },
+    { "array_index",
+      "var a = []; for (var i = 0; i < 1024; i++) a.push(i);"
+      "function bench(n) { var s = 0; for (var i = 0; i < n; i++) s += a[i & 1023]; return s; }" },
+    { "array_map",
+      "var a = [1, 2, 3, 4, 5, 6, 7, 8];"
+      "function bench(n) { var r; for (var i = 0; i < n; i++) r = a.map(function(x) { return x * 2; }); return r; }" },
+    { "alloc_object",
+      "function bench(n) { var o; for (var i = 0; i < n; i++) o = { x: i, y: i }; return o; }" },
+    { "gc_full",
+      "var live = []; for (var i = 0; i < 10000; i++) live.push({ i: i, s: 'v' + i });"
+      "function bench(n) { for (var i = 0; i < n; i++) gc(); }" },
+};
+
+#define KERNEL_COUNT (sizeof(kernels) / sizeof(kernels[0]))
+
+static int64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Stub functions required by mqjs_stdlib.h
+static JSValue js_print(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    return JS_UNDEFINED;
+}
+
+static JSValue js_gc(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    JS_GC(ctx);
+    return JS_UNDEFINED;
+}
+
+static JSValue js_date_now(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return JS_NewInt64(ctx, (int64_t)tv.tv_sec * 1000 + (tv.tv_usec / 1000));
+}
+
+static JSValue js_performance_now(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    return JS_NewInt64(ctx, get_time_ns() / 1000000);
+}
+
+static JSValue js_load(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    return JS_ThrowError(ctx, JS_CLASS_ERROR, "load() is not available in benchmarks");
+}
+
+static JSValue js_setTimeout(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    return JS_ThrowError(ctx, JS_CLASS_ERROR, "setTimeout() is not available in benchmarks");
+}
+
+static JSValue js_clearTimeout(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    return JS_ThrowError(ctx, JS_CLASS_ERROR, "clearTimeout() is not available in benchmarks");
+}
+
+static JSValue js_fetch(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    return JS_ThrowError(ctx, JS_CLASS_ERROR, "fetch() is not available in benchmarks");
+}
+
+// The gem wraps Math.random to flag evals as impure; no cache here
+static JSValue js_sandbox_math_random(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    return js_math_random(ctx, this_val, argc, argv);
+}
+
+static void report_exception(JSContext *ctx, const char *name) {
+    JSCStringBuf buf;
+    JSValue exc = JS_GetException(ctx);
+    const char *msg = JS_ToCString(ctx, exc, &buf);
+    fprintf(stderr, "%s: %s\n", name, msg ? msg : "exception");
+}
+
+// Call bench(n) once; returns elapsed nanoseconds or -1 on exception
+static int64_t run_once(JSContext *ctx, const char *name, int n) {
+    JSValue global = JS_GetGlobalObject(ctx);
+    JSValue func = JS_GetPropertyStr(ctx, global, "bench");
+
+    if (JS_StackCheck(ctx, 3)) {
+        report_exception(ctx, name);
+        return -1;
+    }
+    JS_PushArg(ctx, JS_NewInt32(ctx, n));
+    JS_PushArg(ctx, func);
+    JS_PushArg(ctx, JS_NULL);
+
+    int64_t start_ns = get_time_ns();
+    JSValue ret = JS_Call(ctx, 1);
+    int64_t elapsed_ns = get_time_ns() - start_ns;
+
+    if (JS_IsException(ret)) {
+        report_exception(ctx, name);
+        return -1;
+    }
+    return elapsed_ns;
+}
+
+static int compare_int64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int run_kernel(const Kernel *kernel, size_t memory_size, int reps, int warmup,
+                      int64_t target_ns) {
+    void *mem = malloc(memory_size);
+    if (!mem) {
+        fprintf(stderr, "%s: cannot allocate %zu bytes\n", kernel->name, memory_size);
+        return -1;
+    }
+
+    JSContext *ctx = JS_NewContext(mem, memory_size, &js_stdlib);
+    JS_SetRandomSeed(ctx, 42);
+
+    int status = -1;
+    JSValue val = JS_Eval(ctx, kernel->source, strlen(kernel->source), "<bench>", 0);
+    if (JS_IsException(val)) {
+        report_exception(ctx, kernel->name);
+        goto done;
+    }
+
+    // Double n until a single run reaches the target duration
+    int n = 1;
+    for (;;) {
+        int64_t elapsed_ns = run_once(ctx, kernel->name, n);
+        if (elapsed_ns < 0)
+            goto done;
+        if (elapsed_ns >= target_ns || n >= (1 << 30))
+            break;
+        n *= 2;
+    }
+
+    for (int i = 0; i < warmup; i++) {
+        if (run_once(ctx, kernel->name, n) < 0)
+            goto done;
+    }
+
+    int64_t *samples = malloc(sizeof(int64_t) * reps);
+    for (int i = 0; i < reps; i++) {
+        samples[i] = run_once(ctx, kernel->name, n);
+        if (samples[i] < 0) {
+            free(samples);
+            goto done;
+        }
+    }
+    qsort(samples, reps, sizeof(int64_t), compare_int64);
+
+    printf("%-20s %12d %12.2f %12.2f %12.2f\n", kernel->name, n,
+           (double)samples[reps / 2] / n, (double)samples[0] / n,
+           (double)samples[reps - 1] / n);
+    free(samples);
+    status = 0;
+
+done:
+    JS_FreeContext(ctx);
+    free(mem);
+    return status;
+}
+
+static int matches_filter(const char *name, int filter_count, char **filters) {
+    if (filter_count == 0)
+        return 1;
+    for (int i = 0; i < filter_count; i++) {
+        if (strstr(name, filters[i]))
+            return 1;
+    }
+    return 0;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: engine_bench [-r reps] [-w warmup] [-t target_ms] [-m memory_mb] [-l] [name-filter...]\n"
+            "  -r  timed repetitions per kernel (default 5)\n"
+            "  -w  untimed warmup runs per kernel (default 2)\n"
+            "  -t  calibrated duration of one run in ms (default 50)\n"
+            "  -m  context memory in MB (default 16)\n"
+            "  -l  list kernels and exit\n");
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    int reps = 5, warmup = 2, target_ms = 50, memory_mb = 16;
+    int i;
+
+    for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+        const char *opt = argv[i];
+        if (!strcmp(opt, "-l")) {
+            for (size_t k = 0; k < KERNEL_COUNT; k++)
+                printf("%s\n", kernels[k].name);
+            return 0;
+        }
+        if (i + 1 >= argc)
+            usage();
+        int value = atoi(argv[++i]);
+        if (value <= 0)
+            usage();
+        if (!strcmp(opt, "-r"))
+            reps = value;
+        else if (!strcmp(opt, "-w"))
+            warmup = value;
+        else if (!strcmp(opt, "-t"))
+            target_ms = value;
+        else if (!strcmp(opt, "-m"))
+            memory_mb = value;
+        else
+            usage();
+    }
+
+    printf("reps: %d, warmup: %d, target: %d ms, memory: %d MB\n\n", reps, warmup, target_ms, memory_mb);
+    printf("%-20s %12s %12s %12s %12s\n", "kernel", "ops/run", "median ns", "min ns", "max ns");
+
+    int failures = 0;
+    for (size_t k = 0; k < KERNEL_COUNT; k++) {
+        if (!matches_filter(kernels[k].name, argc - i, argv + i))
+            continue;
+        if (run_kernel(&kernels[k], (size_t)memory_mb << 20, reps, warmup,
+                       (int64_t)target_ms * 1000000) < 0)
+            failures++;
+    }
+    return failures ? 1 : 0;
+}
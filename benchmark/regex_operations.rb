@@ -0,0 +1,196 @@
+# frozen_string_literal: true
+
+require 'benchmark'
+require_relative '../lib/mquickjs'
+require_relative 'results'
+
+module Benchmarks
+  class RegexOperations
+    # Realistic patterns, each run against a generated corpus of the same shape
+    PATTERNS = [
+      { name: "log: request line", corpus: :log,
+        source: '"(GET|POST|PUT|DELETE) ([^ "]+) HTTP/1\\.[01]" (\\d{3})', flags: "g" },
+      { name: "log: IPv4 address", corpus: :log,
+        source: '\\b\\d{1,3}\\.\\d{1,3}\\.\\d{1,3}\\.\\d{1,3}\\b', flags: "g" },
+      { name: "csv: quoted field", corpus: :csv,
+        source: '"(?:[^"]|"")*"', flags: "g" },
+      { name: "csv: field separator", corpus: :csv,
+        source: ',', flags: "g" },
+      { name: "email: address", corpus: :email,
+        source: '[A-Za-z0-9._%+-]+@[A-Za-z0-9.-]+\\.[A-Za-z]{2,}', flags: "g" },
+      { name: "url: http(s) link", corpus: :url,
+        source: 'https?://[^\\s/$.?#][^\\s]*', flags: "gi" }
+    ].freeze
+
+    # Classic catastrophic-backtracking cases. The subject never matches, so
+    # the engine explores an exponential number of paths until interrupted.
+    PATHOLOGICAL = [
+      { name: "(a+)+b", source: "(a+)+b", subject: "a" * 40 + "c" },
+      { name: "(a|aa)+$", source: "(a|aa)+$", subject: "a" * 60 + "!" },
+      { name: "(x+x+)+y", source: "(x+x+)+y", subject: "x" * 40 },
+      { name: "^(\\w+\\s?)*$", source: "^(\\w+\\s?)*$", subject: "word " * 12 + "!" },
+      { name: "^(.*a){20}$", source: "^(.*a){20}$", subject: "a" * 30 + "b" }
+    ].freeze
+
+    # Each operation returns the number of matches it observed
+    OPERATIONS = {
+      "test" => <<~JS,
+        (function() {
+          var re = new RegExp(pattern_source, pattern_flags), n = 0;
+          while (re.test(input)) {
+            n++;
+            if (re.lastIndex === 0) break;
+          }
+          return n;
+        })()
+      JS
+      "exec" => <<~JS,
+        (function() {
+          var re = new RegExp(pattern_source, pattern_flags), n = 0, m;
+          while ((m = re.exec(input)) !== null) {
+            n++;
+            if (m[0].length === 0) re.lastIndex++;
+          }
+          return n;
+        })()
+      JS
+      "replace" => <<~JS,
+        (function() {
+          var n = 0;
+          input.replace(new RegExp(pattern_source, pattern_flags), function() { n++; return ""; });
+          return n;
+        })()
+      JS
+      # Captured groups are spliced into the split result, so divide them out
+      "split" => <<~JS
+        (function() {
+          var groups = new RegExp(pattern_source + "|").exec("").length;
+          return (input.split(new RegExp(pattern_source, pattern_flags)).length - 1) / groups;
+        })()
+      JS
+    }.freeze
+
+    def self.run(iterations: 3, input_size: 2_000_000, timeout_ms: 1000)
+      puts "\n=== Regex Operations Benchmark ==="
+      puts "Iterations: #{iterations}, input size: #{(input_size / 1_000_000.0).round(1)} MB per corpus"
+
+      corpora = build_corpora(input_size)
+      sandbox = MQuickJS::Sandbox.new(memory_limit: 64 * 1024 * 1024, timeout_ms: 120_000)
+
+      puts format("\n  %-24s %-8s %10s %14s %10s %10s",
+                  "Pattern", "Op", "Matches", "Matches/s", "MB/s", "ms/iter")
+
+      PATTERNS.each do |pattern|
+        input = corpora.fetch(pattern[:corpus])
+        sandbox.set_variable("input", input)
+        sandbox.set_variable("pattern_source", pattern[:source])
+        sandbox.set_variable("pattern_flags", pattern[:flags])
+
+        OPERATIONS.each do |op, code|
+          matches = sandbox.eval(code).value # warmup
+          elapsed = measure do
+            Results.record("regex_operations", "#{pattern[:name]} #{op}") { iterations.times { sandbox.eval(code) } }
+          end / iterations
+
+          puts format("  %-24s %-8s %10d %14.0f %10.2f %10.2f",
+                      pattern[:name], op, matches, matches / elapsed,
+                      input.bytesize / elapsed / 1_000_000.0, elapsed * 1000)
+        end
+
+        # Release the corpus before loading the next one
+        sandbox.eval("input = null; null")
+      end
+
+      run_pathological(timeout_ms)
+    end
+
+    # Measures how long each catastrophic pattern runs before the sandbox
+    # timeout fires, i.e. how promptly lre_exec polls for interrupts.
+    def self.run_pathological(timeout_ms)
+      puts "\n  Catastrophic backtracking (timeout_ms: #{timeout_ms}):"
+      puts format("  %-24s %-10s %14s %14s", "Pattern", "Outcome", "Elapsed (ms)", "Overshoot (ms)")
+
+      PATHOLOGICAL.each do |pattern|
+        sandbox = MQuickJS::Sandbox.new(timeout_ms: timeout_ms)
+        sandbox.set_variable("pattern_source", pattern[:source])
+        sandbox.set_variable("subject", pattern[:subject])
+
+        outcome = "completed"
+        elapsed = measure do
+          Results.record("regex_operations", "pathological #{pattern[:name]}") do
+            sandbox.eval("new RegExp(pattern_source).test(subject)")
+          rescue MQuickJS::TimeoutError
+            outcome = "timeout"
+          end
+        end
+
+        elapsed_ms = elapsed * 1000
+        overshoot = outcome == "timeout" ? format("%14.2f", elapsed_ms - timeout_ms) : format("%14s", "-")
+        puts format("  %-24s %-10s %14.2f %s", pattern[:name], outcome, elapsed_ms, overshoot)
+      end
+    end
+
+    def self.measure
+      start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+      yield
+      Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+    end
+
+    def self.build_corpora(input_size)
+      rng = Random.new(42)
+      {
+        log: build_corpus(input_size) { log_line(rng) },
+        csv: build_corpus(input_size) { csv_line(rng) },
+        email: build_corpus(input_size) { email_line(rng) },
+        url: build_corpus(input_size) { url_line(rng) }
+      }
+    end
+
+    def self.build_corpus(input_size)
+      lines = []
+      size = 0
+      while size < input_size
+        line = yield
+        lines << line
+        size += line.bytesize + 1
+      end
+      lines.join("\n")
+    end
+
+    WORDS = %w[alpha beta gamma delta epsilon zeta theta kappa lambda sigma omega].freeze
+    METHODS = %w[GET GET GET POST PUT DELETE].freeze
+
+    def self.log_line(rng)
+      ip = Array.new(4) { rng.rand(256) }.join(".")
+      path = "/api/v1/#{WORDS.sample(random: rng)}/#{rng.rand(100_000)}"
+      status = [200, 200, 200, 201, 301, 404, 500].sample(random: rng)
+      "#{ip} - - [10/Oct/2023:13:55:#{format('%02d', rng.rand(60))} +0000] " \
+        "\"#{METHODS.sample(random: rng)} #{path} HTTP/1.1\" #{status} #{rng.rand(10_000)} \"-\" \"Mozilla/5.0\""
+    end
+
+    def self.csv_line(rng)
+      [
+        rng.rand(1_000_000),
+        "\"#{WORDS.sample(random: rng)}, #{WORDS.sample(random: rng)}\"",
+        WORDS.sample(random: rng),
+        "\"say \"\"#{WORDS.sample(random: rng)}\"\"\"",
+        format("%.2f", rng.rand * 1000)
+      ].join(",")
+    end
+
+    def self.email_line(rng)
+      user = "#{WORDS.sample(random: rng)}.#{WORDS.sample(random: rng)}#{rng.rand(100)}"
+      "From: #{WORDS.sample(random: rng).capitalize} <#{user}@#{WORDS.sample(random: rng)}.example.com> " \
+        "Subject: re: #{WORDS.sample(random: rng)} #{WORDS.sample(random: rng)}"
+    end
+
+    def self.url_line(rng)
+      "see https://#{WORDS.sample(random: rng)}.example.org/#{WORDS.sample(random: rng)}?id=#{rng.rand(1000)} " \
+        "and HTTP://cdn.example.net/#{WORDS.sample(random: rng)}.png for #{WORDS.sample(random: rng)} details"
+    end
+  end
+end
+
+if __FILE__ == $0
+  Benchmarks::RegexOperations.run
+end
@@ -0,0 +1,177 @@
+# frozen_string_literal: true
+
+require 'benchmark'
+require 'json'
+require 'time'
+require_relative '../lib/mquickjs'
+
+module Benchmarks
+  # Machine-readable benchmark results, written when BENCHMARK_JSON names
+  # an output file (runner.rb sets it from --json)
+  #
+  # While recording, every Sandbox#eval made by the recording thread is
+  # timed on its own, and every Benchmark report (x.report) becomes one
+  # result, so the Benchmark.bm suites need no changes. Suites that print
+  # their own tables call Results.record or Results.add.
+  module Results
+    @entries = []
+    @recording = nil
+    @enabled = false
+
+    # One Results.record block in progress
+    class Recording
+      attr_reader :thread, :samples
+
+      def initialize
+        @thread = Thread.current
+        @samples = []
+        @sandboxes = {}.compare_by_identity
+      end
+
+      # Restart peak tracking the first time a sandbox evals in this block
+      def watch(sandbox)
+        return if @sandboxes.key?(sandbox)
+
+        sandbox.memory_usage(reset_peak: true)
+        @sandboxes[sandbox] = true
+      end
+
+      def peak_heap_bytes
+        @sandboxes.keys.map { |sandbox| sandbox.memory_usage[:peak_heap_size] }.max
+      end
+    end
+
+    class << self
+      attr_reader :entries, :recording
+
+      def enabled?
+        @enabled
+      end
+
+      def enable!
+        @enabled = true
+      end
+
+      # Run the block, timing each eval it makes, and add one result named
+      # "suite/name". Blocks that make no eval count as a single sample.
+      def record(suite, name)
+        return yield unless enabled?
+
+        recording = Recording.new
+        @recording = recording
+        allocated = GC.stat(:total_allocated_objects)
+        start = now
+        begin
+          yield
+        ensure
+          total_s = now - start
+          @recording = nil
+          samples = recording.samples.empty? ? [total_s * 1_000_000] : recording.samples
+          add(suite: suite, name: name, samples_us: samples, total_s: total_s,
+              allocations: GC.stat(:total_allocated_objects) - allocated,
+              peak_heap_bytes: recording.peak_heap_bytes)
+        end
+      end
+
+      def add(suite:, name:, samples_us:, total_s: nil, allocations: nil, peak_heap_bytes: nil)
+        return unless enabled?
+
+        sorted = samples_us.sort
+        mean = sorted.sum / sorted.size
+        variance = sorted.size > 1 ? sorted.sum { |s| (s - mean)**2 } / (sorted.size - 1) : 0.0
+
+        @entries << {
+          suite: suite,
+          name: name,
+          iterations: sorted.size,
+          total_s: (total_s || sorted.sum / 1_000_000).round(6),
+          mean_us: mean.round(3),
+          stddev_us: Math.sqrt(variance).round(3),
+          p50_us: percentile(sorted, 50).round(3),
+          p99_us: percentile(sorted, 99).round(3),
+          min_us: sorted.first.round(3),
+          max_us: sorted.last.round(3),
+          allocations: allocations,
+          peak_heap_bytes: peak_heap_bytes,
+          samples_us: samples_us.map { |s| s.round(3) }
+        }
+      end
+
+      def write(path)
+        document = {
+          meta: {
+            ruby_version: RUBY_VERSION,
+            platform: RUBY_PLATFORM,
+            mquickjs_version: MQuickJS::VERSION,
+            git_revision: git_revision,
+            created_at: Time.now.utc.iso8601
+          },
+          results: @entries
+        }
+        File.write(path, JSON.pretty_generate(document))
+        puts "\nWrote #{@entries.size} results to #{path}"
+      end
+
+      # Name of the benchmark file that called x.report, e.g. "json_operations"
+      def suite_from(locations)
+        location = locations.find do |loc|
+          path = loc.absolute_path.to_s
+          path.start_with?(__dir__) && path != __FILE__
+        end
+        location ? File.basename(location.path, ".rb") : "benchmark"
+      end
+
+      def percentile(sorted, pct)
+        sorted[((sorted.size - 1) * pct / 100.0).round]
+      end
+
+      def now
+        Process.clock_gettime(Process::CLOCK_MONOTONIC)
+      end
+
+      private
+
+      def git_revision
+        revision = `git -C #{__dir__} rev-parse --short HEAD 2>/dev/null`.strip
+        revision.empty? ? nil : revision
+      rescue SystemCallError
+        nil
+      end
+    end
+
+    # Times each eval made while a recording is active on this thread
+    module SandboxTiming
+      def eval(code, **options)
+        recording = Results.recording
+        return super unless recording && recording.thread == Thread.current
+
+        recording.watch(self)
+        start = Results.now
+        begin
+          super
+        ensure
+          recording.samples << (Results.now - start) * 1_000_000
+        end
+      end
+    end
+
+    # Turns each Benchmark.bm report into a result
+    module ReportRecording
+      def item(label = "", *format, &block)
+        return super unless Results.enabled?
+
+        suite = Results.suite_from(caller_locations)
+        Results.record(suite, label.strip.delete_suffix(":")) { super(label, *format, &block) }
+      end
+      alias report item
+    end
+  end
+end
+
+MQuickJS::Sandbox.prepend(Benchmarks::Results::SandboxTiming)
+Benchmark::Report.prepend(Benchmarks::Results::ReportRecording)
+
+if (path = ENV["BENCHMARK_JSON"])
+  Benchmarks::Results.enable!
+  at_exit { Benchmarks::Results.write(path) }
+end
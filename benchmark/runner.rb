@@ -1,13 +1,23 @@
 #!/usr/bin/env ruby
 # frozen_string_literal: true
 
+# ruby benchmark/runner.rb [--json results.json]
+if (index = ARGV.index("--json"))
+  ENV["BENCHMARK_JSON"] = ARGV[index + 1] || abort("--json needs an output file")
+end
+
 require_relative 'simple_operations'
 require_relative 'computation'
 require_relative 'json_operations'
 require_relative 'array_operations'
 require_relative 'sandbox_overhead'
+require_relative 'sandbox_lifecycle'
 require_relative 'memory_limits'
+require_relative 'gc_pressure'
 require_relative 'console_output'
+require_relative 'regex_operations'
+require_relative 'kernels'
+require_relative 'concurrency'
 
 puts "=" * 70
 puts "MQuickJS Benchmark Suite"
@@ -22,8 +32,13 @@ Benchmarks::Computation.run
 Benchmarks::JsonOperations.run
 Benchmarks::ArrayOperations.run
 Benchmarks::SandboxOverhead.run
+Benchmarks::SandboxLifecycle.run
 Benchmarks::MemoryLimits.run
+Benchmarks::GcPressure.run
 Benchmarks::ConsoleOutput.run
+Benchmarks::RegexOperations.run
+Benchmarks::Kernels.run
+Benchmarks::Concurrency.run
 
 puts "\n" + "=" * 70
 puts "Benchmark suite completed!"
@@ -0,0 +1,104 @@
+# frozen_string_literal: true
+
+require_relative '../lib/mquickjs'
+require_relative 'results'
+
+module Benchmarks
+  class SandboxLifecycle
+    MEMORY_LIMITS = [50_000, 256_000, 1024 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024, 64 * 1024 * 1024].freeze
+
+    SMALL_INPUT = 42
+    MEDIUM_INPUT = {
+      "id" => 1234, "name" => "Ada Lovelace", "email" => "ada@example.com", "active" => true,
+      "tags" => %w[admin beta billing], "address" => { "city" => "London", "zip" => "N1 9GU" }
+    }.freeze
+    LARGE_INPUT = Array.new(200) do |i|
+      { "id" => i, "name" => "item #{i}", "price" => i * 1.25, "tags" => ["t#{i % 7}", "t#{i % 11}"] }
+    end.freeze
+
+    # Phases of one sandbox-per-request lifecycle, in the order they run
+    PHASES = [
+      "arena malloc", "JS_NewContext", "Sandbox.new (total)", "first eval", "steady eval",
+      "set_variable small", "set_variable medium", "set_variable large", "close"
+    ].freeze
+
+    def self.run(iterations: 1000)
+      puts "\n=== Sandbox Lifecycle Benchmark ==="
+      puts "Iterations: #{iterations} sandboxes per memory limit, latencies in microseconds"
+      puts "Inputs: small = Integer, medium = #{MEDIUM_INPUT.to_s.bytesize} B hash, " \
+           "large = #{LARGE_INPUT.size} hashes (#{LARGE_INPUT.to_s.bytesize} B)"
+
+      MEMORY_LIMITS.each do |limit|
+        samples = measure(limit, iterations)
+
+        puts "\n  memory_limit: #{format_bytes(limit)}"
+        puts format("  %-22s %10s %10s %10s %10s", "Phase", "p50", "p90", "p99", "max")
+        PHASES.each do |phase|
+          values = samples[phase]
+          Results.add(suite: "sandbox_lifecycle", name: "#{format_bytes(limit)} #{phase}", samples_us: values)
+          sorted = values.sort
+          puts format("  %-22s %10.1f %10.1f %10.1f %10.1f", phase,
+                      percentile(sorted, 50), percentile(sorted, 90), percentile(sorted, 99), sorted.last)
+        end
+
+        totals = samples[:request].sort
+        puts format("  %-22s %10.1f %10.1f %10.1f %10.1f", "request (new..close)",
+                    percentile(totals, 50), percentile(totals, 90), percentile(totals, 99), totals.last)
+      end
+
+      puts "\n  arena malloc and JS_NewContext come from Sandbox#creation_timings; Sandbox.new"
+      puts "  (total) adds the Ruby wrapper. request is the wall time of one new/first eval/"
+      puts "  steady eval/set_variable x3/close cycle."
+    end
+
+    # One sandbox per iteration, each going through every phase once.
+    # Returns per-phase latencies in microseconds.
+    def self.measure(limit, iterations)
+      samples = Hash.new { |hash, key| hash[key] = [] }
+      GC.start
+
+      iterations.times do
+        request_start = now
+        sandbox = nil
+        time(samples, "Sandbox.new (total)") do
+          sandbox = MQuickJS::Sandbox.new(memory_limit: limit, timeout_ms: 10_000)
+        end
+        creation = sandbox.creation_timings
+        samples["arena malloc"] << creation[:arena_alloc_ms] * 1000
+        samples["JS_NewContext"] << creation[:new_context_ms] * 1000
+
+        time(samples, "first eval") { sandbox.eval("1 + 1") }
+        time(samples, "steady eval") { sandbox.eval("1 + 1") }
+        time(samples, "set_variable small") { sandbox.set_variable("small", SMALL_INPUT) }
+        time(samples, "set_variable medium") { sandbox.set_variable("medium", MEDIUM_INPUT) }
+        time(samples, "set_variable large") { sandbox.set_variable("large", LARGE_INPUT) }
+        time(samples, "close") { sandbox.close }
+        samples[:request] << (now - request_start) * 1_000_000
+      end
+
+      samples
+    end
+
+    def self.time(samples, phase)
+      start = now
+      yield
+      samples[phase] << (now - start) * 1_000_000
+    end
+
+    def self.format_bytes(bytes)
+      bytes >= 1024 * 1024 ? "#{bytes / (1024 * 1024)} MB" : "#{bytes / 1000} KB"
+    end
+
+    def self.percentile(sorted, pct)
+      sorted[((sorted.size - 1) * pct / 100.0).round]
+    end
+
+    def self.now
+      Process.clock_gettime(Process::CLOCK_MONOTONIC)
+    end
+  end
+end
+
+if __FILE__ == $0
+  Benchmarks::SandboxLifecycle.run
+end
@@ -51,6 +51,37 @@ if File.exist?(stdlib_generator_src)
 
   puts "Generated #{stdlib_header}"
 
+  # One more stdlib per profile in profiles/, each listing the global
+  # object properties it keeps. They are compiled into the extension next
+  # to the full stdlib and selected per sandbox with Sandbox.new(stdlib:).
+  profiles = Dir[File.join(MQUICKJS_DIR, 'profiles', '*.txt')].sort.map do |profile|
+    name = File.basename(profile, '.txt')
+    abort "Invalid stdlib profile name '#{name}'" unless name.match?(/\A[a-z][a-z0-9_]*\z/) && name != 'full'
+
+    profile_header = File.join(MQUICKJS_DIR, "mqjs_stdlib_#{name}.h")
+    generate_profile_cmd = "#{generator_exe} -m64 -n js_stdlib_#{name} -p #{profile} > #{profile_header}"
+    puts generate_profile_cmd
+
+    unless system(generate_profile_cmd)
+      abort "Failed to generate #{profile_header}"
+    end
+
+    name
+  end
+
+  File.open(File.join(MQUICKJS_DIR, 'mqjs_stdlib_profiles.h'), 'w') do |f|
+    f.puts '/* this file is automatically generated - do not edit */'
+    f.puts
+    profiles.each { |name| f.puts "#include \"mqjs_stdlib_#{name}.h\"" }
+    f.puts
+    f.puts 'static const struct { const char *name; const JSSTDLibraryDef *def; } js_stdlib_profiles[] = {'
+    f.puts '    { "full", &js_stdlib },'
+    profiles.each { |name| f.puts "    { \"#{name}\", &js_stdlib_#{name} }," }
+    f.puts '};'
+  end
+
+  puts "Generated stdlib profiles: #{(['full'] + profiles).join(', ')}"
+
   # Clean up generator executable
   FileUtils.rm_f(generator_exe)
 end
@@ -68,8 +99,15 @@ unless find_header('mquickjs.h', MQUICKJS_DIR)
   abort "mquickjs.h not found in #{MQUICKJS_DIR}"
 end
 
+# Interned (fstring) hash keys in results, Ruby 3.0+
+have_func('rb_enc_interned_str', 'ruby/encoding.h')
+
 # Add compilation flags
 $CFLAGS << ' -std=c99 -Wall -Wextra'
 
+# Opcode/slow-path counters for Sandbox#opcode_stats. Off by default: they
+# add a branch to every opcode dispatch.
+$CFLAGS << ' -DJS_OPCODE_STATS' if ENV['MQUICKJS_OPCODE_STATS'] == '1'
+
 # Create Makefile
 create_makefile('mquickjs/mquickjs_native')
@@ -215,7 +215,7 @@ static const JSPropDef js_math[] = {
     JS_CFUNC_SPECIAL_DEF("exp", 1, f_f, js_exp ),
     JS_CFUNC_SPECIAL_DEF("log", 1, f_f, js_log ),
     JS_CFUNC_DEF("pow", 2, js_math_pow ),
-    JS_CFUNC_DEF("random", 0, js_math_random ),
+    JS_CFUNC_DEF("random", 0, js_sandbox_math_random ),
 
     /* some ES6 functions */
     JS_CFUNC_DEF("imul", 2, js_math_imul ),
@@ -0,0 +1,8 @@
+/* this file is automatically generated - do not edit */
+
+#include "mqjs_stdlib_minimal.h"
+
+static const struct { const char *name; const JSSTDLibraryDef *def; } js_stdlib_profiles[] = {
+    { "full", &js_stdlib },
+    { "minimal", &js_stdlib_minimal },
+};
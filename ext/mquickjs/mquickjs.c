@@ -144,7 +144,8 @@ typedef struct {
 typedef struct JSVarRef {
     JS_MB_HEADER;
     JSWord is_detached : 1;
-    JSWord dummy: JS_MB_PAD(JS_MTAG_BITS + 1);
+    JSWord is_global : 1; /* global variable, a property of the global object */
+    JSWord dummy: JS_MB_PAD(JS_MTAG_BITS + 2);
     union {
         JSValue value; /* is_detached = true */
         struct {
@@ -220,10 +221,13 @@ struct JSContext {
     uint8_t string_pos_cache_counter; /* used for string_pos_cache[] update */
     uint16_t class_count; /* number of classes including user classes */
     int16_t interrupt_counter;
+    int16_t interrupt_period; /* value of interrupt_counter after each poll */
     BOOL current_exception_is_uncatchable : 8;
     struct JSParseState *parse_state; /* != NULL during JS_Eval() */
     int unique_strings_len;
     int js_call_rec_count; /* number of recursing JS_Call() */
+    BOOL suspended : 8; /* TRUE if a JS_Run() waits for JS_Resume() */
+    JSValue *suspended_initial_fp; /* initial_fp of the suspended JS_Call() */
     JSGCRef *top_gc_ref; /* used to reference temporary GC roots (stack top) */
     JSGCRef *last_gc_ref; /* used to reference temporary GC roots (list) */
     const JSWord *atom_table; /* constant atom table */
@@ -233,10 +237,21 @@ struct JSContext {
     const JSCFinalizer *c_finalizer_table;
     uint64_t random_state;
     JSInterruptHandler *interrupt_handler;
+    JSGCHook *gc_hook;
+    JSAllocSampleFunc *alloc_sample_func;
+    uint32_t alloc_sample_interval; /* in bytes */
+    int64_t alloc_sample_countdown; /* bytes until the next sample */
+    uint32_t write_count; /* see JS_GetWriteCount() */
+    uint8_t *write_watermark; /* blocks below it existed at the last
+                                 JS_StartWriteTracking() */
     JSWriteFunc *write_func; /* for the various dump functions */
     void *opaque;
     JSValue *class_obj; /* same as class_proto + class_count */
     JSStringPosCacheEntry string_pos_cache[JS_STRING_POS_CACHE_SIZE];
+#ifdef JS_OPCODE_STATS
+    JSOpcodeStats *opcode_stats; /* != NULL if opcode counting is enabled */
+    int last_opcode; /* previously executed opcode, -1 if none */
+#endif
                                            
     /* must only contain JSValue from this point (see JS_GC()) */
     JSValue unique_strings; /* JSValueArray of sorted strings or JS_NULL */
@@ -377,6 +392,7 @@ static int JS_ToUint8Clamp(JSContext *ctx, int *pres, JSValue val);
 static JSValue js_set_prototype_internal(JSContext *ctx, JSValue obj, JSValue proto);
 static JSValue js_resize_byte_array(JSContext *ctx, JSValue val, int new_size);
 static JSValueArray *js_alloc_props(JSContext *ctx, int n);
+static int get_first_free(JSValueArray *arr);
 
 typedef enum OPCodeFormat {
 #define FMT(f) OP_FMT_ ## f,
@@ -421,6 +437,42 @@ static __maybe_unused const JSOpCode opcode_info[OP_COUNT] = {
 #undef FMT
 };
 
+#ifdef JS_OPCODE_STATS
+static const char * const opcode_names[OP_COUNT] = {
+#define FMT(f)
+#define DEF(id, size, n_pop, n_push, f) #id,
+#define def(id, size, n_pop, n_push, f)
+#include "mquickjs_opcode.h"
+#undef def
+#undef DEF
+#undef FMT
+};
+
+static const char * const slow_path_names[JS_SLOW_PATH_COUNT] = {
+    "add",
+    "binary_arith",
+    "unary_arith",
+    "post_inc_dec",
+    "binary_logic",
+    "not",
+    "relational",
+    "eq",
+    "strict_eq",
+    "get_field",
+    "get_length",
+    "put_field",
+    "get_array_el",
+    "put_array_el",
+};
+
+#define COUNT_SLOW_PATH(id) do {                                        \
+        if (unlikely(ctx->opcode_stats != NULL))                        \
+            ctx->opcode_stats->slow_path_count[JS_SLOW_PATH_ ## id]++;  \
+    } while (0)
+#else
+#define COUNT_SLOW_PATH(id) do { } while (0)
+#endif
+
 #include "mquickjs_atom.h"
 
 JSValue *JS_PushGCRef(JSContext *ctx, JSGCRef *ref)
@@ -545,6 +597,18 @@ static void *js_malloc(JSContext *ctx, uint32_t size, int mtag)
     p->mtag = mtag;
     p->gc_mark = 0;
     p->dummy = 0;
+
+    if (unlikely(ctx->alloc_sample_func != NULL)) {
+        ctx->alloc_sample_countdown -= size;
+        if (ctx->alloc_sample_countdown <= 0) {
+            uint32_t samples = 0;
+            do {
+                samples++;
+                ctx->alloc_sample_countdown += ctx->alloc_sample_interval;
+            } while (ctx->alloc_sample_countdown <= 0);
+            ctx->alloc_sample_func(ctx, ctx->opaque, size, mtag, samples);
+        }
+    }
     return p;
 }
 
@@ -572,6 +636,14 @@ static void js_free(JSContext *ctx, void *ptr)
         ctx->heap_free = ptr;
 }
 
+/* count a write to the heap block 'ptr' if it already existed at the
+   last JS_StartWriteTracking() */
+static inline void js_note_write(JSContext *ctx, const void *ptr)
+{
+    if ((const uint8_t *)ptr < ctx->write_watermark)
+        ctx->write_count++;
+}
+
 /* 'size' is in bytes and must be multiple of JSW and > 0 */
 static void set_free_block(void *ptr, uint32_t size)
 {
@@ -612,6 +684,12 @@ JSValue JS_Throw(JSContext *ctx, JSValue obj)
     return JS_EXCEPTION;
 }
 
+JSValue JS_SetUncatchableException(JSContext *ctx)
+{
+    ctx->current_exception_is_uncatchable = TRUE;
+    return JS_EXCEPTION;
+}
+
 /* return the byte length. 'buf' must contain UTF8_CHAR_LEN_MAX + 1 bytes */
 static int get_short_string(uint8_t *buf, JSValue val)
 {
@@ -2655,6 +2733,65 @@ JSValue JS_GetPropertyUint32(JSContext *ctx, JSValue obj, uint32_t idx)
     return JS_GetProperty(ctx, obj, JS_NewInt32(ctx, idx));
 }
 
+uint32_t JS_GetWriteCount(JSContext *ctx)
+{
+    return ctx->write_count;
+}
+
+void JS_StartWriteTracking(JSContext *ctx)
+{
+    ctx->write_watermark = ctx->heap_free;
+}
+
+int JS_GetArrayLength(JSContext *ctx, JSValue obj)
+{
+    JSObject *p;
+
+    if (!JS_IsObject(ctx, obj))
+        return -1;
+    p = JS_VALUE_TO_PTR(obj);
+    if (p->class_id != JS_CLASS_ARRAY)
+        return -1;
+    return p->u.array.len;
+}
+
+JS_BOOL JS_GetOwnPropertyAt(JSContext *ctx, JSValue obj, uint32_t *ppos,
+                            JSValue *pkey, JSValue *pval)
+{
+    JSObject *p;
+    JSValueArray *arr;
+    JSProperty *pr;
+    int hash_mask, first_free, idx;
+
+    if (!JS_IsObject(ctx, obj))
+        return FALSE;
+    p = JS_VALUE_TO_PTR(obj);
+    arr = JS_VALUE_TO_PTR(p->props);
+    hash_mask = JS_VALUE_GET_INT(arr->arr[1]);
+    first_free = get_first_free(arr);
+    for(;;) {
+        idx = 2 + hash_mask + 1 + 3 * (*ppos);
+        if (idx >= first_free)
+            return FALSE;
+        (*ppos)++;
+        pr = (JSProperty *)&arr->arr[idx];
+        /* exclude deleted properties */
+        if (pr->key != JS_UNINITIALIZED)
+            break;
+    }
+    *pkey = pr->key;
+    if (pr->prop_type == JS_PROP_NORMAL) {
+        *pval = pr->value;
+    } else if (pr->prop_type == JS_PROP_VARREF) {
+        JSVarRef *pv = JS_VALUE_TO_PTR(pr->value);
+        *pval = pv->u.value;
+    } else {
+        /* getter or special property: must be read with a full get */
+        *pval = JS_UNINITIALIZED;
+    }
+    return TRUE;
+}
+
 static BOOL JS_HasProperty(JSContext *ctx, JSValue obj, JSValue prop)
 {
     JSObject *p;
@@ -2943,6 +3080,7 @@ static JSValue JS_DefinePropertyInternal(JSContext *ctx, JSValue obj,
     JSGCRef obj_ref, prop_ref, val_ref, setter_ref;
     int ret;
     
+    js_note_write(ctx, JS_VALUE_TO_PTR(obj));
     /* move to RAM if needed */
     JS_PUSH_VALUE(ctx, obj);
     JS_PUSH_VALUE(ctx, prop);
@@ -3029,8 +3167,10 @@ static JSValue JS_DefinePropertyInternal(JSContext *ctx, JSValue obj,
         if (!pv)
             return JS_EXCEPTION;
         pv->is_detached = TRUE;
+        pv->is_global = TRUE;
         pv->u.value = val;
         val = JS_VALUE_FROM_PTR(pv);
+        ctx->write_count++;
     }
     JS_PUSH_VALUE(ctx, val);
     pr = js_create_property(ctx, obj, prop);
@@ -3075,8 +3215,10 @@ static JSValue add_global_var(JSContext *ctx, JSValue prop, BOOL define_flag)
         if (define_flag) {
             JSVarRef *pv = JS_VALUE_TO_PTR(pr->value);
             /* define the variable if needed */
-            if (pv->u.value == JS_UNINITIALIZED)
+            if (pv->u.value == JS_UNINITIALIZED) {
                 pv->u.value = JS_UNDEFINED;
+                ctx->write_count++;
+            }
         }
         return pr->value;
     }
@@ -3141,6 +3283,7 @@ static JSValue JS_SetPropertyInternal(JSContext *ctx, JSValue this_obj,
             return JS_ThrowTypeError(ctx, "cannot set property '%"JSValue_PRI"' of value", prop);
         }
     }
+    js_note_write(ctx, p);
 
     /* search if the property is already present */
     if (p->class_id == JS_CLASS_ARRAY) {
@@ -3210,6 +3353,7 @@ static JSValue JS_SetPropertyInternal(JSContext *ctx, JSValue this_obj,
                 goto invalid_array_subscript;
             idx += p->u.typed_array.offset;
             pbuffer = JS_VALUE_TO_PTR(p->u.typed_array.buffer);
+            js_note_write(ctx, pbuffer);
             arr = JS_VALUE_TO_PTR(pbuffer->u.array_buffer.byte_buffer);
             switch(p->class_id) {
             default:
@@ -3252,6 +3396,7 @@ static JSValue JS_SetPropertyInternal(JSContext *ctx, JSValue this_obj,
             JSVarRef *pv = JS_VALUE_TO_PTR(pr->value);
             /* always detached */
             pv->u.value = val;
+            ctx->write_count++;
             return JS_UNDEFINED;
         } else if (pr->prop_type == JS_PROP_SPECIAL) {
             JSGCRef val_ref, prop_ref, this_obj_ref;
@@ -3400,6 +3545,10 @@ static JSValue JS_DeleteProperty(JSContext *ctx, JSValue this_obj,
                 pr = (JSProperty *)(arr->arr + idx);
             }
             /* found: remove it */
+            if (this_obj == ctx->global_obj)
+                ctx->write_count++;
+            else
+                js_note_write(ctx, p);
             if (last_idx >= 0) {
                 JSProperty *lpr = (JSProperty *)(arr->arr + last_idx);
                 lpr->hash_next = pr->hash_next;
@@ -3552,6 +3701,7 @@ JSContext *JS_NewContext2(void *mem_start, size_t mem_size, const JSSTDLibraryDe
     ctx->unique_strings = JS_NULL;
 #endif    
     ctx->random_state = 1;
+    ctx->interrupt_period = JS_INTERRUPT_COUNTER_INIT;
     ctx->write_func = dummy_write_func;
     for(i = 0; i < JS_STRING_POS_CACHE_SIZE; i++)
         ctx->string_pos_cache[i].str = JS_NULL;
@@ -3659,11 +3809,74 @@ void JS_SetContextOpaque(JSContext *ctx, void *opaque)
     ctx->opaque = opaque;
 }
 
+void *JS_GetContextOpaque(JSContext *ctx)
+{
+    return ctx->opaque;
+}
+
 void JS_SetInterruptHandler(JSContext *ctx, JSInterruptHandler *interrupt_handler)
 {
     ctx->interrupt_handler = interrupt_handler;
 }
 
+void JS_SetInterruptPeriod(JSContext *ctx, int period)
+{
+    if (period <= 0)
+        period = JS_INTERRUPT_COUNTER_INIT;
+    ctx->interrupt_period = min_int(period, INT16_MAX);
+    if (ctx->interrupt_counter > ctx->interrupt_period)
+        ctx->interrupt_counter = ctx->interrupt_period;
+}
+
+void JS_SetGCHook(JSContext *ctx, JSGCHook *gc_hook)
+{
+    ctx->gc_hook = gc_hook;
+}
+
+void JS_SetAllocSampler(JSContext *ctx, JSAllocSampleFunc *func,
+                        uint32_t sample_interval)
+{
+    if (sample_interval == 0)
+        func = NULL;
+    ctx->alloc_sample_func = func;
+    ctx->alloc_sample_interval = sample_interval;
+    ctx->alloc_sample_countdown = sample_interval;
+}
+
+int JS_SetOpcodeStats(JSContext *ctx, JSOpcodeStats *stats)
+{
+#ifdef JS_OPCODE_STATS
+    ctx->opcode_stats = stats;
+    ctx->last_opcode = -1;
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+int JS_GetOpcodeCount(void)
+{
+    return OP_COUNT;
+}
+
+const char *JS_GetOpcodeName(int op)
+{
+#ifdef JS_OPCODE_STATS
+    if (op >= 0 && op < OP_COUNT)
+        return opcode_names[op];
+#endif
+    return NULL;
+}
+
+const char *JS_GetSlowPathName(int idx)
+{
+#ifdef JS_OPCODE_STATS
+    if (idx >= 0 && idx < JS_SLOW_PATH_COUNT)
+        return slow_path_names[idx];
+#endif
+    return NULL;
+}
+
 void JS_SetLogFunc(JSContext *ctx, JSWriteFunc *write_func)
 {
     ctx->write_func = write_func;
@@ -3699,6 +3912,7 @@ static JSValue get_var_ref(JSContext *ctx, JSValue *pfirst_var_ref, JSValue *pva
     if (!p)
         return JS_EXCEPTION;
     p->is_detached = FALSE;
+    p->is_global = FALSE;
     p->u.pvalue = pval;
     p->u.next = *pfirst_var_ref;
     val = JS_VALUE_FROM_PTR(p);
@@ -3910,7 +4124,7 @@ static void get_pc2line(int *pline_num, int *pcol_num, const uint8_t *buf,
     *pcol_num = col_num;
 }
 
-/* return 0 if line/col number info */
+/* return 0 if line/col number info. 'pc' may point inside an opcode. */
 static int find_line_col(int *pcol_num, JSFunctionBytecode *b, uint32_t pc)
 {
     JSByteArray *arr, *pc2line;
@@ -3932,11 +4146,11 @@ static int find_line_col(int *pcol_num, JSFunctionBytecode *b, uint32_t pc)
     while (pos < arr->size) {
         get_pc2line(&line_num, &col_num, pc2line->buf, pc2line->size,
                     &pc2line_pos, b->has_column);
-        if (pos == pc) {
+        op = arr->buf[pos];
+        if (pc < (uint32_t)(pos + opcode_info[op].size)) {
             *pcol_num = col_num;
             return line_num;
         }
-        op = arr->buf[pos];
         pos += opcode_info[op].size;
     }
  fail:
@@ -4019,6 +4233,38 @@ static void build_backtrace(JSContext *ctx, JSValue error_obj,
     p1->u.error.stack = stack_str;
 }
 
+int JS_WalkStack(JSContext *ctx, JSStackFrameFunc *func, void *opaque,
+                 int max_levels)
+{
+    JSValue *fp;
+    JSCStringBuf name_buf, filename_buf;
+    JSFunctionBytecode *b;
+    JSStackFrame frame;
+    int level;
+
+    fp = ctx->fp;
+    level = 0;
+    while (fp != (JSValue *)ctx->stack_top && level < max_levels) {
+        frame.func_name = get_func_name(ctx, fp[FRAME_OFFSET_FUNC_OBJ], &name_buf, &b);
+        if (frame.func_name && frame.func_name[0] == '\0')
+            frame.func_name = NULL;
+        if (b) {
+            frame.filename = JS_ToCString(ctx, b->filename, &filename_buf);
+            frame.line_num = find_line_col(&frame.col_num, b,
+                                           JS_VALUE_GET_INT(fp[FRAME_OFFSET_CUR_PC]) - 1);
+        } else {
+            frame.filename = NULL;
+            frame.line_num = 0;
+            frame.col_num = 0;
+        }
+        level++;
+        if (func(opaque, &frame))
+            break;
+        fp = VALUE_TO_SP(ctx, fp[FRAME_OFFSET_SAVED_FP]);
+    }
+    return level;
+}
+
 #define HINT_STRING  0
 #define HINT_NUMBER  1
 #define HINT_NONE    HINT_NUMBER
@@ -5031,10 +5277,23 @@ static JSValue js_call_constructor_start(JSContext *ctx, JSValue func)
         pc = ((JSByteArray *)JS_VALUE_TO_PTR(b->byte_code))->buf + JS_VALUE_GET_INT(fp[FRAME_OFFSET_CUR_PC]); \
     } while (0)
 
-static JSValue __js_poll_interrupt(JSContext *ctx)
+/* 'suspendable' is TRUE if the interpreter state is fully saved in
+   the stack frames at this point */
+static JSValue __js_poll_interrupt(JSContext *ctx, BOOL suspendable)
 {
-    ctx->interrupt_counter = JS_INTERRUPT_COUNTER_INIT;
-    if (ctx->interrupt_handler && ctx->interrupt_handler(ctx, ctx->opaque)) {
+    int ret;
+    
+    ctx->interrupt_counter = ctx->interrupt_period;
+    if (!ctx->interrupt_handler)
+        return JS_UNDEFINED;
+    ret = ctx->interrupt_handler(ctx, ctx->opaque);
+    if (ret == JS_INTERRUPT_SUSPEND) {
+        /* C frames cannot be kept, so only the outermost JS_Call()
+           is suspended. Otherwise run until the next suspendable
+           poll. */
+        if (suspendable && ctx->js_call_rec_count == 1)
+            ctx->suspended = TRUE;
+    } else if (ret) {
         JS_ThrowInternalError(ctx, "interrupted");
         ctx->current_exception_is_uncatchable = TRUE;
         return JS_EXCEPTION;
@@ -5043,16 +5302,23 @@ static JSValue __js_poll_interrupt(JSContext *ctx)
 }
 
 /* handle user interruption */
-#define POLL_INTERRUPT() do {                           \
-        if (unlikely(--ctx->interrupt_counter <= 0)) {  \
-            SAVE();                                     \
-            val = __js_poll_interrupt(ctx);             \
-            RESTORE();                                  \
-            if (JS_IsException(val))                    \
-                goto exception;                         \
-        }                                               \
+#define POLL_INTERRUPT(suspendable) do {                        \
+        if (unlikely(--ctx->interrupt_counter <= 0)) {          \
+            SAVE();                                             \
+            val = __js_poll_interrupt(ctx, suspendable);        \
+            RESTORE();                                          \
+            if (JS_IsException(val))                            \
+                goto exception;                                 \
+            if ((suspendable) && unlikely(ctx->suspended))      \
+                goto suspend;                                   \
+        }                                                       \
     } while(0)
 
+/* 'resume_mode' of js_call_internal() */
+#define JS_CALL_NORMAL 0
+#define JS_CALL_RESUME 1 /* continue a suspended call */
+#define JS_CALL_ABORT  2 /* unwind a suspended call */
+
 /* must use JS_StackCheck() before using it */
 void JS_PushArg(JSContext *ctx, JSValue val)
 {
@@ -5071,7 +5337,7 @@ void JS_PushArg(JSContext *ctx, JSValue val)
    JS_PushArg(ctx, this_obj);
    res = JS_Call(ctx, n);
 */
-JSValue JS_Call(JSContext *ctx, int call_flags)
+static JSValue js_call_internal(JSContext *ctx, int call_flags, int resume_mode)
 {
     JSValue *fp, *sp, val = JS_UNDEFINED, *initial_fp;
     uint8_t *pc;
@@ -5091,6 +5357,19 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
     initial_fp = fp;
     b = NULL;
     pc = NULL;
+    if (unlikely(resume_mode != JS_CALL_NORMAL)) {
+        /* the frames and the pc were saved by POLL_INTERRUPT() */
+        initial_fp = ctx->suspended_initial_fp;
+        ctx->suspended = FALSE;
+        if (resume_mode == JS_CALL_ABORT) {
+            val = JS_ThrowInternalError(ctx, "interrupted");
+            ctx->current_exception_is_uncatchable = TRUE;
+            RESTORE();
+            goto exception;
+        }
+        RESTORE();
+        goto restart;
+    }
     goto function_call;
 
 #define CASE(op)        case op
@@ -5099,6 +5378,15 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
     
     for(;;) {
         opcode = *pc++;
+#ifdef JS_OPCODE_STATS
+        if (unlikely(ctx->opcode_stats != NULL)) {
+            JSOpcodeStats *stats = ctx->opcode_stats;
+            stats->op_count[opcode]++;
+            if (stats->op_pair_count && ctx->last_opcode >= 0)
+                stats->op_pair_count[ctx->last_opcode * OP_COUNT + opcode]++;
+            ctx->last_opcode = opcode;
+        }
+#endif
 #ifdef DUMP_EXEC
         {
             JSByteArray *arr;
@@ -5336,7 +5624,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                 js_reverse_val(sp, n);
                 
             generic_function_call:
-                POLL_INTERRUPT();
+                POLL_INTERRUPT(FALSE);
                 byte_code = JS_VALUE_TO_PTR(b->byte_code);
                 /* save pc + 1 of the current call */
                 fp[FRAME_OFFSET_CUR_PC] = JS_NewShortInt(pc - byte_code->buf);
@@ -5781,6 +6069,10 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                     RESTORE();
                     goto exception;
                 }
+                if (pv->is_global)
+                    ctx->write_count++;
+                else if (pv->is_detached)
+                    js_note_write(ctx, pv);
                 *pval = *sp++;
                 pc += 2;
             }
@@ -5788,7 +6080,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
 
         CASE(OP_goto):
             pc += (int32_t)get_u32(pc);
-            POLL_INTERRUPT();
+            POLL_INTERRUPT(TRUE);
             BREAK;
         CASE(OP_if_false):
         CASE(OP_if_true):
@@ -5801,7 +6093,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                 if (res ^ (OP_if_true - opcode)) {
                     pc += (int32_t)get_u32(pc - 4) - 4;
                 }
-                POLL_INTERRUPT();
+                POLL_INTERRUPT(TRUE);
             }
             BREAK;
 
@@ -5856,6 +6148,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                     }
                 } else {
                 get_field_slow:
+                    COUNT_SLOW_PATH(GET_FIELD);
                     SAVE();
                     val = JS_GetPropertyInternal(ctx, obj, prop, TRUE);
                     RESTORE();
@@ -5904,6 +6197,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                     val = JS_NewShortInt(JS_VALUE_GET_SPECIAL_VALUE(val) >= 0x10000 ? 2 : 1); 
                 } else {
                 get_length_slow:
+                    COUNT_SLOW_PATH(GET_LENGTH);
                     SAVE();
                     val = JS_GetPropertyInternal(ctx, obj, js_get_atom(ctx, JS_ATOM_length), TRUE);
                     RESTORE();
@@ -5942,10 +6236,12 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                     /* XXX: slow */
                     if (unlikely(JS_IS_ROM_PTR(ctx, pr)))
                         goto put_field_slow;
+                    js_note_write(ctx, p);
                     pr->value = sp[0];
                     sp += 2;
                 } else {
                 put_field_slow:
+                    COUNT_SLOW_PATH(PUT_FIELD);
                     val = *sp++;
                     SAVE();
                     val = JS_SetPropertyInternal(ctx, sp[0], prop, val, TRUE);
@@ -5989,6 +6285,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                     val = arr->arr[idx];
                 } else {
                 get_array_el_slow:
+                    COUNT_SLOW_PATH(GET_ARRAY_EL);
                     SAVE();
                     prop = JS_ToPropertyKey(ctx, prop);
                     RESTORE();
@@ -6023,6 +6320,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                         goto put_array_el_slow;
                     if (unlikely(p->class_id != JS_CLASS_ARRAY))
                         goto put_array_el_slow;
+                    js_note_write(ctx, p);
                     idx = JS_VALUE_GET_INT(prop);
                     arr = JS_VALUE_TO_PTR(p->u.array.tab);
                     if (unlikely(idx >= p->u.array.len)) {
@@ -6040,6 +6338,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                     sp += 3;
                 } else {
                 put_array_el_slow:
+                    COUNT_SLOW_PATH(PUT_ARRAY_EL);
                     SAVE();
                     sp[1] = JS_ToPropertyKey(ctx, sp[1]);
                     RESTORE();
@@ -6123,6 +6422,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
 #endif
                 {
                 add_slow:
+                    COUNT_SLOW_PATH(ADD);
                     SAVE();
                     val = js_add_slow(ctx);
                     RESTORE();
@@ -6245,6 +6545,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
             BREAK;
         CASE(OP_pow):
         binary_arith_slow:
+            COUNT_SLOW_PATH(BINARY_ARITH);
             SAVE();
             val = js_binary_arith_slow(ctx, opcode);
             RESTORE();
@@ -6346,6 +6647,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                     sp[0] = JS_NewShortInt(v1 - 1);
                 } else {
                 unary_arith_slow:
+                    COUNT_SLOW_PATH(UNARY_ARITH);
                     SAVE();
                     val = js_unary_arith_slow(ctx, opcode);
                     RESTORE();
@@ -6368,6 +6670,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                     val = JS_NewShortInt(v1);
                 } else {
                 slow_post_inc_dec:
+                    COUNT_SLOW_PATH(POST_INC_DEC);
                     SAVE();
                     val = js_post_inc_slow(ctx, opcode);
                     RESTORE();
@@ -6385,6 +6688,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                 if (JS_IsInt(op1)) {
                     sp[0] = (~op1) & (~1);
                 } else {
+                    COUNT_SLOW_PATH(NOT);
                     SAVE();
                     val = js_not_slow(ctx);
                     RESTORE();
@@ -6493,6 +6797,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                     sp++;
                 } else {
                 binary_logic_slow:
+                    COUNT_SLOW_PATH(BINARY_LOGIC);
                     SAVE();
                     val = js_binary_logic_slow(ctx, opcode);
                     RESTORE();
@@ -6505,7 +6810,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
             BREAK;
             
 
-#define OP_CMP(opcode, binary_op, slow_call)              \
+#define OP_CMP(opcode, binary_op, slow_call, slow_id)     \
             CASE(opcode):                                  \
                 {                                         \
                 JSValue op1, op2;                         \
@@ -6515,6 +6820,7 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                     sp[1] = JS_NewBool(JS_VALUE_GET_INT(op1) binary_op JS_VALUE_GET_INT(op2)); \
                     sp++;                                               \
                 } else {                                                \
+                    COUNT_SLOW_PATH(slow_id);                           \
                     SAVE();                                             \
                     val = slow_call;                                    \
                     RESTORE();                                          \
@@ -6526,14 +6832,14 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
                 }                                                       \
                 BREAK;
             
-            OP_CMP(OP_lt, <, js_relational_slow(ctx, opcode));
-            OP_CMP(OP_lte, <=, js_relational_slow(ctx, opcode));
-            OP_CMP(OP_gt, >, js_relational_slow(ctx, opcode));
-            OP_CMP(OP_gte, >=, js_relational_slow(ctx, opcode));
-            OP_CMP(OP_eq, ==, js_eq_slow(ctx, 0));
-            OP_CMP(OP_neq, !=, js_eq_slow(ctx, 1));
-            OP_CMP(OP_strict_eq, ==, js_strict_eq_slow(ctx, 0));
-            OP_CMP(OP_strict_neq, !=, js_strict_eq_slow(ctx, 1));
+            OP_CMP(OP_lt, <, js_relational_slow(ctx, opcode), RELATIONAL);
+            OP_CMP(OP_lte, <=, js_relational_slow(ctx, opcode), RELATIONAL);
+            OP_CMP(OP_gt, >, js_relational_slow(ctx, opcode), RELATIONAL);
+            OP_CMP(OP_gte, >=, js_relational_slow(ctx, opcode), RELATIONAL);
+            OP_CMP(OP_eq, ==, js_eq_slow(ctx, 0), EQ);
+            OP_CMP(OP_neq, !=, js_eq_slow(ctx, 1), EQ);
+            OP_CMP(OP_strict_eq, ==, js_strict_eq_slow(ctx, 0), STRICT_EQ);
+            OP_CMP(OP_strict_neq, !=, js_strict_eq_slow(ctx, 1), STRICT_EQ);
         CASE(OP_in):
             SAVE();
             val = js_operator_in(ctx);
@@ -6598,6 +6904,10 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
         }
       restart: ;
     } /* switch */
+ suspend:
+    /* the frames stay on the stack until JS_Resume() */
+    ctx->suspended_initial_fp = initial_fp;
+    val = JS_UNDEFINED;
  done:
     ctx->sp = sp;
     ctx->fp = fp;
@@ -6608,6 +6918,25 @@ JSValue JS_Call(JSContext *ctx, int call_flags)
 #undef SAVE
 #undef RESTORE
 
+JSValue JS_Call(JSContext *ctx, int call_flags)
+{
+    return js_call_internal(ctx, call_flags, JS_CALL_NORMAL);
+}
+
+JS_BOOL JS_IsSuspended(JSContext *ctx)
+{
+    return ctx->suspended;
+}
+
+JSValue JS_Resume(JSContext *ctx, JS_BOOL abort)
+{
+    if (!ctx->suspended)
+        return JS_ThrowTypeError(ctx, "no suspended run");
+    if (ctx->js_call_rec_count != 0)
+        return JS_ThrowInternalError(ctx, "cannot resume from a nested call");
+    return js_call_internal(ctx, 0, abort ? JS_CALL_ABORT : JS_CALL_RESUME);
+}
+
 static inline int is_ident_first(int c)
 {
     return (c >= 'a' && c <= 'z') ||
@@ -12309,7 +12638,7 @@ static void gc_thread_block(JSContext *ctx, void *ptr)
 /* Heap compaction using Jonkers algorithm */
 static void gc_compact_heap(JSContext *ctx)
 {
-    uint8_t *ptr, *new_ptr;
+    uint8_t *ptr, *new_ptr, *watermark;
     int size;
     JSValue *sp, *sp_end;
     
@@ -12365,10 +12694,15 @@ static void gc_compact_heap(JSContext *ctx)
     }
     
     /* pass 2: update the threaded pointers and move the block to its
-       final position */
+       final position. The blocks keep their order, so the write
+       watermark moves to the new position of the first block above it. */
     new_ptr = ctx->heap_base;
     ptr = ctx->heap_base;
+    watermark = ctx->write_watermark;
+    ctx->write_watermark = NULL;
     while (ptr < ctx->heap_free) {
+        if (watermark && ptr >= watermark && !ctx->write_watermark)
+            ctx->write_watermark = new_ptr;
         gc_update_threaded_pointers(ctx, ptr, new_ptr);
         size = get_mblock_size(ptr);
         if (js_get_mtag(ptr) != JS_MTAG_FREE) {
@@ -12379,6 +12713,8 @@ static void gc_compact_heap(JSContext *ctx)
         }
         ptr += size;
     }
+    if (watermark && !ctx->write_watermark)
+        ctx->write_watermark = new_ptr;
     ctx->heap_free = new_ptr;
 
     /* update the source pointer in the parser */
@@ -12404,6 +12740,8 @@ static void gc_compact_heap(JSContext *ctx)
 
 static void JS_GC2(JSContext *ctx, BOOL keep_atoms)
 {
+    if (ctx->gc_hook)
+        ctx->gc_hook(ctx, ctx->opaque, FALSE);
 #ifdef DUMP_GC
     js_printf(ctx, "GC   : heap size=%u/%u stack_size=%u\n",
            (uint32_t)(ctx->heap_free - ctx->heap_base),
@@ -12435,6 +12773,8 @@ static void JS_GC2(JSContext *ctx, BOOL keep_atoms)
            (uint32_t)(ctx->stack_top - ctx->heap_base),
            (uint32_t)(ctx->stack_top - (uint8_t *)ctx->sp));
 #endif
+    if (ctx->gc_hook)
+        ctx->gc_hook(ctx, ctx->opaque, TRUE);
 }
 
 void JS_GC(JSContext *ctx)
@@ -12442,6 +12782,156 @@ void JS_GC(JSContext *ctx)
     JS_GC2(ctx, TRUE);
 }
 
+/* heap introspection */
+
+static void heap_walk_ref(JSContext *ctx, JSHeapEdgeFunc *func, void *opaque,
+                          uint32_t from, JSValue val)
+{
+    uint8_t *ptr;
+    if (!JS_IsPtr(val))
+        return;
+    ptr = JS_VALUE_TO_PTR(val);
+    /* ignore ROM blocks and non value pointers */
+    if (ptr < ctx->heap_base || ptr >= ctx->heap_free)
+        return;
+    func(opaque, from, ptr - ctx->heap_base);
+}
+
+/* same references as gc_mark_flush() */
+static void heap_walk_block_refs(JSContext *ctx, JSHeapEdgeFunc *func, void *opaque,
+                                 void *ptr)
+{
+    uint32_t from = (uint8_t *)ptr - ctx->heap_base;
+    
+    switch(((JSMemBlockHeader *)ptr)->mtag) {
+    case JS_MTAG_OBJECT:
+        {
+            JSObject *p = ptr;
+            heap_walk_ref(ctx, func, opaque, from, p->proto);
+            heap_walk_ref(ctx, func, opaque, from, p->props);
+            switch(p->class_id) {
+            case JS_CLASS_CLOSURE:
+                {
+                    int i;
+                    heap_walk_ref(ctx, func, opaque, from, p->u.closure.func_bytecode);
+                    for(i = 0; i < (int)p->extra_size - 1; i++)
+                        heap_walk_ref(ctx, func, opaque, from, p->u.closure.var_refs[i]);
+                }
+                break;
+            case JS_CLASS_C_FUNCTION:
+                if (p->extra_size > 1)
+                    heap_walk_ref(ctx, func, opaque, from, p->u.cfunc.params);
+                break;
+            case JS_CLASS_ARRAY:
+                heap_walk_ref(ctx, func, opaque, from, p->u.array.tab);
+                break;
+            case JS_CLASS_ERROR:
+                heap_walk_ref(ctx, func, opaque, from, p->u.error.message);
+                heap_walk_ref(ctx, func, opaque, from, p->u.error.stack);
+                break;
+            case JS_CLASS_ARRAY_BUFFER:
+                heap_walk_ref(ctx, func, opaque, from, p->u.array_buffer.byte_buffer);
+                break;
+            case JS_CLASS_UINT8C_ARRAY:
+            case JS_CLASS_INT8_ARRAY:
+            case JS_CLASS_UINT8_ARRAY:
+            case JS_CLASS_INT16_ARRAY:
+            case JS_CLASS_UINT16_ARRAY:
+            case JS_CLASS_INT32_ARRAY:
+            case JS_CLASS_UINT32_ARRAY:
+            case JS_CLASS_FLOAT32_ARRAY:
+            case JS_CLASS_FLOAT64_ARRAY:
+                heap_walk_ref(ctx, func, opaque, from, p->u.typed_array.buffer);
+                break;
+            case JS_CLASS_REGEXP:
+                heap_walk_ref(ctx, func, opaque, from, p->u.regexp.source);
+                heap_walk_ref(ctx, func, opaque, from, p->u.regexp.byte_code);
+                break;
+            }
+        }
+        break;
+    case JS_MTAG_VALUE_ARRAY:
+        {
+            JSValueArray *p = ptr;
+            int i;
+            for(i = 0; i < (int)p->size; i++)
+                heap_walk_ref(ctx, func, opaque, from, p->arr[i]);
+        }
+        break;
+    case JS_MTAG_VARREF:
+        {
+            JSVarRef *p = ptr;
+            heap_walk_ref(ctx, func, opaque, from, p->u.value);
+        }
+        break;
+    case JS_MTAG_FUNCTION_BYTECODE:
+        {
+            JSFunctionBytecode *b = ptr;
+            heap_walk_ref(ctx, func, opaque, from, b->func_name);
+            heap_walk_ref(ctx, func, opaque, from, b->byte_code);
+            heap_walk_ref(ctx, func, opaque, from, b->cpool);
+            heap_walk_ref(ctx, func, opaque, from, b->vars);
+            heap_walk_ref(ctx, func, opaque, from, b->ext_vars);
+            heap_walk_ref(ctx, func, opaque, from, b->filename);
+            heap_walk_ref(ctx, func, opaque, from, b->pc2line);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void JS_WalkHeap(JSContext *ctx, JSHeapBlockFunc *block_func,
+                 JSHeapEdgeFunc *edge_func, void *opaque)
+{
+    uint8_t *ptr;
+    JSHeapBlock block;
+    
+    for(ptr = ctx->heap_base; ptr < ctx->heap_free; ptr += block.size) {
+        block.offset = ptr - ctx->heap_base;
+        block.size = get_mblock_size(ptr);
+        block.mtag = ((JSMemBlockHeader *)ptr)->mtag;
+        if (block.mtag == JS_MTAG_OBJECT)
+            block.class_id = ((JSObject *)ptr)->class_id;
+        else
+            block.class_id = -1;
+        if (block_func)
+            block_func(opaque, &block);
+        if (edge_func)
+            heap_walk_block_refs(ctx, edge_func, opaque, ptr);
+    }
+
+    if (edge_func) {
+        JSValue *sp, *sp_end;
+        JSGCRef *ref;
+        
+        /* same roots as gc_mark_all() */
+        sp_end = ctx->class_proto + 2 * ctx->class_count;
+        for(sp = &ctx->current_exception; sp < sp_end; sp++)
+            heap_walk_ref(ctx, edge_func, opaque, JS_HEAP_ROOT, *sp);
+        for(sp = ctx->sp; sp < (JSValue *)ctx->stack_top; sp++)
+            heap_walk_ref(ctx, edge_func, opaque, JS_HEAP_ROOT, *sp);
+        for(ref = ctx->top_gc_ref; ref != NULL; ref = ref->prev)
+            heap_walk_ref(ctx, edge_func, opaque, JS_HEAP_ROOT, ref->val);
+        for(ref = ctx->last_gc_ref; ref != NULL; ref = ref->prev)
+            heap_walk_ref(ctx, edge_func, opaque, JS_HEAP_ROOT, ref->val);
+    }
+}
+
+void JS_GetMemoryUsage(JSContext *ctx, JSMemoryUsage *usage)
+{
+    usage->heap_size = ctx->heap_free - ctx->heap_base;
+    usage->stack_size = ctx->stack_top - (uint8_t *)ctx->sp;
+    usage->total_size = ctx->stack_top - ctx->heap_base;
+}
+
+const char *JS_GetMTagName(int mtag)
+{
+    if (mtag < 0 || mtag >= JS_MTAG_COUNT)
+        return NULL;
+    return js_mtag_name[mtag];
+}
+
 /* bytecode saving and loading */
 
 #define JS_BYTECODE_VERSION_32 0x0001
@@ -13726,6 +14216,7 @@ static JSValue js_set_prototype_internal(JSContext *ctx, JSValue obj, JSValue pr
     JSObject *p, *p1;
 
     p = JS_VALUE_TO_PTR(obj);
+    js_note_write(ctx, p);
     if (p->proto != proto) {
         if (proto != JS_NULL) {
             /* check if there is a cycle */
@@ -13837,6 +14328,269 @@ JSValue js_object_keys(JSContext *ctx, JSValue *this_val,
     return ret;
 }
 
+/* JS_CloneValue() */
+
+#define JS_CLONE_MAX_DEPTH 1000
+#define JS_CLONE_MEMO_INIT_SIZE 16 /* power of two */
+
+typedef struct {
+    uint32_t src; /* offset in JSWords from the source context, 0 if free */
+    uint32_t idx; /* in JSCloneState.copies */
+} JSCloneMemoEntry;
+
+typedef struct {
+    JSContext *src_ctx;
+    JSGCRef copies_ref; /* JSValueArray of the copied objects and strings */
+    JSGCRef memo_ref; /* JSByteArray: hash table of JSCloneMemoEntry */
+    uint32_t copy_count;
+    uint32_t memo_mask;
+    int depth;
+} JSCloneState;
+
+/* return the entry of the block at offset 'src' or the free entry
+   where to add it */
+static JSCloneMemoEntry *js_clone_memo_find(JSCloneState *s, uint32_t src)
+{
+    JSByteArray *arr = JS_VALUE_TO_PTR(s->memo_ref.val);
+    JSCloneMemoEntry *tab = (JSCloneMemoEntry *)arr->buf;
+    uint32_t h;
+
+    h = src * 0x9e3779b1;
+    for(;;) {
+        h &= s->memo_mask;
+        if (tab[h].src == src || tab[h].src == 0)
+            return &tab[h];
+        h++;
+    }
+}
+
+/* 0 for ROM blocks, which are not recorded: they are never part of a
+   cycle */
+static uint32_t js_clone_memo_offset(JSCloneState *s, const void *ptr)
+{
+    if (JS_IS_ROM_PTR(s->src_ctx, ptr))
+        return 0;
+    return ((uintptr_t)ptr - (uintptr_t)s->src_ctx) / JSW;
+}
+
+static inline JSValue js_clone_get_copy(JSCloneState *s, uint32_t idx)
+{
+    JSValueArray *arr = JS_VALUE_TO_PTR(s->copies_ref.val);
+    return arr->arr[idx];
+}
+
+/* record 'val' as the copy of the block at offset 'src'. Return its
+   index or -1 if exception. 'val' may be moved, use
+   js_clone_get_copy() */
+static int js_clone_memo_add(JSContext *ctx, JSCloneState *s, uint32_t src, JSValue val)
+{
+    JSGCRef val_ref;
+    JSValue copies;
+    JSByteArray *arr, *old_arr;
+    JSCloneMemoEntry *tab, *e;
+    uint32_t i, old_size, size;
+
+    JS_PUSH_VALUE(ctx, val);
+    copies = js_resize_value_array(ctx, s->copies_ref.val, s->copy_count + 1);
+    if (JS_IsException(copies))
+        goto fail;
+    s->copies_ref.val = copies;
+
+    /* keep the hash table at most 3/4 full */
+    old_size = s->memo_mask + 1;
+    if ((s->copy_count + 1) * 4 > old_size * 3) {
+        size = old_size * 2;
+        arr = js_alloc_byte_array(ctx, size * sizeof(JSCloneMemoEntry));
+        if (!arr)
+            goto fail;
+        memset(arr->buf, 0, size * sizeof(JSCloneMemoEntry));
+        old_arr = JS_VALUE_TO_PTR(s->memo_ref.val);
+        s->memo_ref.val = JS_VALUE_FROM_PTR(arr);
+        s->memo_mask = size - 1;
+        tab = (JSCloneMemoEntry *)old_arr->buf;
+        for(i = 0; i < old_size; i++) {
+            if (tab[i].src != 0)
+                *js_clone_memo_find(s, tab[i].src) = tab[i];
+        }
+    }
+    JS_POP_VALUE(ctx, val);
+
+    if (src != 0) {
+        e = js_clone_memo_find(s, src);
+        e->src = src;
+        e->idx = s->copy_count;
+    }
+    ((JSValueArray *)JS_VALUE_TO_PTR(s->copies_ref.val))->arr[s->copy_count] = val;
+    return s->copy_count++;
+ fail:
+    JS_POP_VALUE(ctx, val);
+    return -1;
+}
+
+static JSValue js_clone_value(JSContext *ctx, JSCloneState *s, JSValue val);
+
+static JSValue js_clone_array(JSContext *ctx, JSCloneState *s, JSObject *p, uint32_t src)
+{
+    JSObject *p1;
+    JSValueArray *tab;
+    JSValue copy, v;
+    uint32_t len, i;
+    int idx;
+
+    len = p->u.array.len;
+    copy = JS_NewArray(ctx, len);
+    if (JS_IsException(copy))
+        return copy;
+    idx = js_clone_memo_add(ctx, s, src, copy);
+    if (idx < 0)
+        return JS_EXCEPTION;
+    for(i = 0; i < len; i++) {
+        tab = JS_VALUE_TO_PTR(p->u.array.tab);
+        v = js_clone_value(ctx, s, tab->arr[i]);
+        if (JS_IsException(v))
+            return v;
+        p1 = JS_VALUE_TO_PTR(js_clone_get_copy(s, idx));
+        tab = JS_VALUE_TO_PTR(p1->u.array.tab);
+        tab->arr[i] = v;
+    }
+    return js_clone_get_copy(s, idx);
+}
+
+static JSValue js_clone_object(JSContext *ctx, JSCloneState *s, JSObject *p, uint32_t src)
+{
+    JSValueArray *arr;
+    JSProperty *pr;
+    JSValue copy, key, v;
+    JSGCRef v_ref;
+    int prop_count, hash_mask, i, j, idx;
+
+    arr = JS_VALUE_TO_PTR(p->props);
+    prop_count = JS_VALUE_GET_INT(arr->arr[0]);
+    hash_mask = JS_VALUE_GET_INT(arr->arr[1]);
+    copy = JS_NewObjectPrealloc(ctx, prop_count);
+    if (JS_IsException(copy))
+        return copy;
+    idx = js_clone_memo_add(ctx, s, src, copy);
+    if (idx < 0)
+        return JS_EXCEPTION;
+    for(i = 0, j = 0; j < prop_count; i++) {
+        pr = (JSProperty *)&arr->arr[2 + hash_mask + 1 + 3 * i];
+        /* exclude deleted properties */
+        if (pr->key == JS_UNINITIALIZED)
+            continue;
+        j++;
+        if (pr->prop_type != JS_PROP_NORMAL)
+            return JS_ThrowTypeError(ctx, "cannot clone a getter or setter");
+        v = js_clone_value(ctx, s, pr->value);
+        if (JS_IsException(v))
+            return v;
+        /* short integer keys are the same in every context */
+        key = pr->key;
+        if (!JS_IsInt(key)) {
+            JS_PUSH_VALUE(ctx, v);
+            key = js_clone_value(ctx, s, key);
+            if (!JS_IsException(key))
+                key = JS_MakeUniqueString(ctx, key);
+            JS_POP_VALUE(ctx, v);
+            if (JS_IsException(key))
+                return key;
+        }
+        if (JS_IsException(JS_DefinePropertyValue(ctx, js_clone_get_copy(s, idx), key, v)))
+            return JS_EXCEPTION;
+    }
+    return js_clone_get_copy(s, idx);
+}
+
+static JSValue js_clone_value(JSContext *ctx, JSCloneState *s, JSValue val)
+{
+    JSCloneMemoEntry *e;
+    JSObject *p;
+    JSString *str;
+    JSValue ret;
+    void *ptr;
+    uint32_t src;
+    int idx;
+
+    if (!JS_IsPtr(val)) {
+        if (JS_VALUE_GET_SPECIAL_TAG(val) == JS_TAG_SHORT_FUNC)
+            return JS_ThrowTypeError(ctx, "cannot clone a function");
+        return val;
+    }
+    ptr = JS_VALUE_TO_PTR(val);
+    if (js_get_mtag(ptr) == JS_MTAG_FLOAT64)
+        return JS_NewFloat64(ctx, ((JSFloat64 *)ptr)->u.dval);
+    src = js_clone_memo_offset(s, ptr);
+    if (src != 0) {
+        e = js_clone_memo_find(s, src);
+        if (e->src != 0)
+            return js_clone_get_copy(s, e->idx);
+    }
+    switch(js_get_mtag(ptr)) {
+    case JS_MTAG_STRING:
+        str = ptr;
+        ret = JS_NewStringLen(ctx, (const char *)str->buf, str->len);
+        if (JS_IsException(ret))
+            return ret;
+        idx = js_clone_memo_add(ctx, s, src, ret);
+        if (idx < 0)
+            return JS_EXCEPTION;
+        return js_clone_get_copy(s, idx);
+    case JS_MTAG_OBJECT:
+        p = ptr;
+        if (s->depth >= JS_CLONE_MAX_DEPTH)
+            return JS_ThrowRangeError(ctx, "value too deeply nested to clone");
+        s->depth++;
+        switch(p->class_id) {
+        case JS_CLASS_ARRAY:
+            ret = js_clone_array(ctx, s, p, src);
+            break;
+        case JS_CLASS_OBJECT:
+            ret = js_clone_object(ctx, s, p, src);
+            break;
+        case JS_CLASS_CLOSURE:
+        case JS_CLASS_C_FUNCTION:
+            ret = JS_ThrowTypeError(ctx, "cannot clone a function");
+            break;
+        default:
+            ret = JS_ThrowTypeError(ctx, "cannot clone this object");
+            break;
+        }
+        s->depth--;
+        return ret;
+    default:
+        return JS_ThrowTypeError(ctx, "cannot clone this value");
+    }
+}
+
+JSValue JS_CloneValue(JSContext *ctx, JSContext *src_ctx, JSValue val)
+{
+    JSCloneState s_s, *s = &s_s;
+    JSByteArray *arr;
+    JSValue ret;
+
+    assert(ctx != src_ctx);
+    if (!JS_IsPtr(val))
+        return js_clone_value(ctx, s, val);
+
+    s->src_ctx = src_ctx;
+    s->copy_count = 0;
+    s->memo_mask = JS_CLONE_MEMO_INIT_SIZE - 1;
+    s->depth = 0;
+    JS_PushGCRef(ctx, &s->copies_ref)[0] = JS_NULL;
+    JS_PushGCRef(ctx, &s->memo_ref)[0] = JS_NULL;
+    arr = js_alloc_byte_array(ctx, JS_CLONE_MEMO_INIT_SIZE * sizeof(JSCloneMemoEntry));
+    if (!arr) {
+        ret = JS_EXCEPTION;
+    } else {
+        memset(arr->buf, 0, JS_CLONE_MEMO_INIT_SIZE * sizeof(JSCloneMemoEntry));
+        s->memo_ref.val = JS_VALUE_FROM_PTR(arr);
+        ret = js_clone_value(ctx, s, val);
+    }
+    JS_PopGCRef(ctx, &s->memo_ref);
+    JS_PopGCRef(ctx, &s->copies_ref);
+    return ret;
+}
+
 JSValue js_object_hasOwnProperty(JSContext *ctx, JSValue *this_val,
                                  int argc, JSValue *argv)
 {
@@ -14039,6 +14793,7 @@ static int js_array_resize(JSContext *ctx, JSValue *this_val, int new_len)
         return -1;
     }
     p = JS_VALUE_TO_PTR(*this_val);
+    js_note_write(ctx, p);
     if (new_len < p->u.array.len) {
         JSValueArray *arr = JS_VALUE_TO_PTR(p->u.array.tab);
         /* shrink the array if the new size is small enough */
@@ -14127,6 +14882,7 @@ JSValue js_array_push(JSContext *ctx, JSValue *this_val,
     p = js_get_array(ctx, *this_val);
     if (!p)
         return JS_EXCEPTION;
+    js_note_write(ctx, p);
     from = p->u.array.len;
     new_len = from + argc;
     if (new_len > JS_SHORTINT_MAX)
@@ -14157,6 +14913,7 @@ JSValue js_array_pop(JSContext *ctx, JSValue *this_val,
     p = js_get_array(ctx, *this_val);
     if (!p)
         return JS_EXCEPTION;
+    js_note_write(ctx, p);
     if (p->u.array.len > 0) {
         JSValueArray *arr = JS_VALUE_TO_PTR(p->u.array.tab);
         ret = arr->arr[--p->u.array.len];
@@ -14175,6 +14932,7 @@ JSValue js_array_shift(JSContext *ctx, JSValue *this_val,
     p = js_get_array(ctx, *this_val);
     if (!p)
         return JS_EXCEPTION;
+    js_note_write(ctx, p);
     if (p->u.array.len > 0) {
         JSValueArray *arr = JS_VALUE_TO_PTR(p->u.array.tab);
         ret = arr->arr[0];
@@ -14274,6 +15032,7 @@ JSValue js_array_reverse(JSContext *ctx, JSValue *this_val,
     p = js_get_array(ctx, *this_val);
     if (!p)
         return JS_EXCEPTION;
+    js_note_write(ctx, p);
     len = p->u.array.len;
     arr = JS_VALUE_TO_PTR(p->u.array.tab);
     js_reverse_val(arr->arr, len);
@@ -14448,6 +15207,7 @@ JSValue js_array_splice(JSContext *ctx, JSValue *this_val,
     /* handling this case has no practical use */
     if (p->u.array.len != len)
         return JS_ThrowTypeError(ctx, "array length was modified");
+    js_note_write(ctx, p);
     arr = JS_VALUE_TO_PTR(p->u.array.tab);
     p1 = JS_VALUE_TO_PTR(obj);
     arr1 = JS_VALUE_TO_PTR(p1->u.array.tab);
@@ -14837,6 +15597,7 @@ JSValue js_array_sort(JSContext *ctx, JSValue *this_val,
     }
     
     p = JS_VALUE_TO_PTR(*this_val);
+    js_note_write(ctx, p);
     arr = JS_VALUE_TO_PTR(p->u.array.tab);
     /* XXX: could resize the array in case it was shrank by the compare function */
     len = min_int(len, p->u.array.len);
@@ -15297,6 +16058,7 @@ JSValue js_typed_array_set(JSContext *ctx, JSValue *this_val,
             JSByteArray *src_arr, *dst_arr;
             int shift = typed_array_size_log2[p->class_id - JS_CLASS_UINT8C_ARRAY];
             dst_buffer = JS_VALUE_TO_PTR(p->u.typed_array.buffer);
+            js_note_write(ctx, dst_buffer);
             dst_arr = JS_VALUE_TO_PTR(dst_buffer->u.array_buffer.byte_buffer);
             src_buffer = JS_VALUE_TO_PTR(p1->u.typed_array.buffer);
             src_arr = JS_VALUE_TO_PTR(src_buffer->u.array_buffer.byte_buffer);
@@ -16929,7 +17691,7 @@ static int lre_exec(JSContext *ctx, JSValue capture_buf,
             JS_PUSH_VALUE(ctx, byte_code);              \
             JS_PUSH_VALUE(ctx, str);                    \
             ctx->sp = sp;                               \
-            ret = __js_poll_interrupt(ctx);             \
+            ret = __js_poll_interrupt(ctx, FALSE);      \
             JS_POP_VALUE(ctx, str);                     \
             JS_POP_VALUE(ctx, byte_code);               \
             JS_POP_VALUE(ctx, capture_buf);             \
@@ -17564,6 +18326,7 @@ JSValue js_regexp_set_lastIndex(JSContext *ctx, JSValue *this_val,
     re = js_get_regexp(ctx, *this_val);
     if (!re)
         return JS_EXCEPTION;
+    js_note_write(ctx, re);
     re->last_index = last_index;
     return JS_UNDEFINED;
 }
@@ -17727,6 +18490,7 @@ JSValue js_regexp_exec(JSContext *ctx, JSValue *this_val,
             if (re_flags & (LRE_FLAG_GLOBAL | LRE_FLAG_STICKY)) {
                 p = JS_VALUE_TO_PTR(*this_val);
                 re = &p->u.regexp;
+                js_note_write(ctx, re);
                 re->last_index = 0;
             }
             if (magic == MAGIC_REGEXP_SEARCH)
@@ -17746,6 +18510,7 @@ JSValue js_regexp_exec(JSContext *ctx, JSValue *this_val,
         if (re_flags & (LRE_FLAG_GLOBAL | LRE_FLAG_STICKY)) {
             p = JS_VALUE_TO_PTR(*this_val);
             re = &p->u.regexp;
+            js_note_write(ctx, re);
             re->last_index = js_string_utf8_to_utf16_pos(ctx, argv[0], capture[1] * 2);
         }
         if (magic == MAGIC_REGEXP_TEST) {
@@ -17943,8 +18708,10 @@ JSValue js_string_replace(JSContext *ctx, JSValue *this_val,
         re_flags = lre_get_flags(bc_arr->buf);
         capture_count = lre_get_capture_count(bc_arr->buf);
 
-        if (re_flags & LRE_FLAG_GLOBAL)
+        if (re_flags & LRE_FLAG_GLOBAL) {
+            js_note_write(ctx, p);
             p->u.regexp.last_index = 0;
+        }
         
         if ((re_flags & (LRE_FLAG_GLOBAL | LRE_FLAG_STICKY)) == 0) {
             last_index = 0;
@@ -17985,6 +18752,7 @@ JSValue js_string_replace(JSContext *ctx, JSValue *this_val,
             if (ret == 0) {
                 if (re_flags & (LRE_FLAG_GLOBAL | LRE_FLAG_STICKY)) {
                     p = JS_VALUE_TO_PTR(argv[0]);
+                    js_note_write(ctx, p);
                     p->u.regexp.last_index = 0;
                 }
                 break;
@@ -17999,6 +18767,7 @@ JSValue js_string_replace(JSContext *ctx, JSValue *this_val,
             if (!(re_flags & LRE_FLAG_GLOBAL)) {
                 if (re_flags & LRE_FLAG_STICKY) {
                     p = JS_VALUE_TO_PTR(argv[0]);
+                    js_note_write(ctx, p);
                     p->u.regexp.last_index = end;
                 }
                 break;
@@ -18107,6 +18876,7 @@ JSValue js_string_split(JSContext *ctx, JSValue *this_val,
         
         if (s == 0) {
             p1 = JS_VALUE_TO_PTR(argv[0]);
+            js_note_write(ctx, p1);
             p1->u.regexp.last_index = 0;
             *z = js_regexp_exec(ctx, &argv[0], 1, this_val, MAGIC_REGEXP_FORCE_GLOBAL);
             if (JS_IsException(*z))
@@ -18118,6 +18888,7 @@ JSValue js_string_split(JSContext *ctx, JSValue *this_val,
         q = 0;
         while (q < s) {
             p1 = JS_VALUE_TO_PTR(argv[0]);
+            js_note_write(ctx, p1);
             p1->u.regexp.last_index = q;
             /* XXX: need sticky behavior */
             *z = js_regexp_exec(ctx, &argv[0], 1, this_val, MAGIC_REGEXP_FORCE_GLOBAL);
@@ -18232,6 +19003,7 @@ JSValue js_string_match(JSContext *ctx, JSValue *this_val,
 
     p = JS_VALUE_TO_PTR(argv[0]);
     re = &p->u.regexp;
+    js_note_write(ctx, re);
     re->last_index = 0;
 
     A = JS_PushGCRef(ctx, &A_ref);
@@ -254,8 +254,10 @@ typedef struct {
 } JSSTDLibraryDef;
 
 typedef void JSWriteFunc(void *opaque, const void *buf, size_t buf_len);
-/* return != 0 if the JS code needs to be interrupted */
+/* return != 0 if the JS code needs to be interrupted, or
+   JS_INTERRUPT_SUSPEND to suspend it (see JS_Resume()) */
 typedef int JSInterruptHandler(JSContext *ctx, void *opaque);
+#define JS_INTERRUPT_SUSPEND 2
 
 JSContext *JS_NewContext(void *mem_start, size_t mem_size, const JSSTDLibraryDef *stdlib_def);
 /* if prepare_compilation is true, the context will be used to compile
@@ -264,10 +266,32 @@ JSContext *JS_NewContext(void *mem_start, size_t mem_size, const JSSTDLibraryDef
 JSContext *JS_NewContext2(void *mem_start, size_t mem_size, const JSSTDLibraryDef *stdlib_def, JS_BOOL prepare_compilation);
 void JS_FreeContext(JSContext *ctx);
 void JS_SetContextOpaque(JSContext *ctx, void *opaque);
+void *JS_GetContextOpaque(JSContext *ctx);
 void JS_SetInterruptHandler(JSContext *ctx, JSInterruptHandler *interrupt_handler);
+/* number of interrupt polls (function calls, backward jumps, regexp
+   steps) between two calls of the interrupt handler. 0 = default. */
+void JS_SetInterruptPeriod(JSContext *ctx, int period);
+/* called before (done = FALSE) and after (done = TRUE) each garbage
+   collection. No JS value may be allocated from it. */
+typedef void JSGCHook(JSContext *ctx, void *opaque, JS_BOOL done);
+void JS_SetGCHook(JSContext *ctx, JSGCHook *gc_hook);
+/* called after an allocation of 'size' bytes once every
+   'sample_interval' allocated bytes. 'samples' is the number of
+   intervals the allocation completed (> 1 for large allocations). The
+   new block is not initialized yet: no JS value may be allocated and
+   the heap may not be walked from it. */
+typedef void JSAllocSampleFunc(JSContext *ctx, void *opaque, uint32_t size,
+                               int mtag, uint32_t samples);
+/* func = NULL or sample_interval = 0 disables the sampling */
+void JS_SetAllocSampler(JSContext *ctx, JSAllocSampleFunc *func,
+                        uint32_t sample_interval);
 void JS_SetRandomSeed(JSContext *ctx, uint64_t seed);
 JSValue JS_GetGlobalObject(JSContext *ctx);
 JSValue JS_Throw(JSContext *ctx, JSValue obj);
+/* make the pending exception uncatchable: try/catch and finally blocks
+   are skipped up to the caller of JS_Run() or JS_Call(). Returns
+   JS_EXCEPTION. */
+JSValue JS_SetUncatchableException(JSContext *ctx);
 JSValue __js_printf_like(3, 4) JS_ThrowError(JSContext *ctx, JSObjectClassEnum error_num,
                                            const char *fmt, ...);
 #define JS_ThrowTypeError(ctx, fmt, ...) JS_ThrowError(ctx, JS_CLASS_TYPE_ERROR, fmt, ##__VA_ARGS__)
@@ -278,6 +302,23 @@ JSValue __js_printf_like(3, 4) JS_ThrowError(JSContext *ctx, JSObjectClassEnum e
 JSValue JS_ThrowOutOfMemory(JSContext *ctx);
 JSValue JS_GetPropertyStr(JSContext *ctx, JSValue this_obj, const char *str);
 JSValue JS_GetPropertyUint32(JSContext *ctx, JSValue obj, uint32_t idx);
+/* counter incremented whenever a global variable is defined, assigned
+   or deleted, by a script or with JS_SetPropertyStr() on the global
+   object, and whenever an object, array, typed array buffer or closure
+   variable allocated before the last JS_StartWriteTracking() is
+   modified. */
+uint32_t JS_GetWriteCount(JSContext *ctx);
+/* from now on, count the writes to the blocks allocated so far */
+void JS_StartWriteTracking(JSContext *ctx);
+/* return the length of an array or -1 if 'obj' is not an array */
+int JS_GetArrayLength(JSContext *ctx, JSValue obj);
+/* iterate over the own properties of 'obj' in creation order without
+   allocating memory. '*ppos' must be 0 for the first call. Return
+   FALSE when there are no more properties. '*pkey' is a short integer
+   or a unique string. '*pval' is JS_UNINITIALIZED for a getter, which
+   must be read with JS_GetPropertyStr(). */
+JS_BOOL JS_GetOwnPropertyAt(JSContext *ctx, JSValue obj, uint32_t *ppos,
+                            JSValue *pkey, JSValue *pval);
 JSValue JS_SetPropertyStr(JSContext *ctx, JSValue this_obj,
                           const char *str, JSValue val);
 JSValue JS_SetPropertyUint32(JSContext *ctx, JSValue this_obj,
@@ -285,6 +326,12 @@ JSValue JS_SetPropertyUint32(JSContext *ctx, JSValue this_obj,
 JSValue JS_NewObjectClassUser(JSContext *ctx, int class_id);
 JSValue JS_NewObject(JSContext *ctx);
 JSValue JS_NewArray(JSContext *ctx, int initial_len);
+/* copy 'val', a value of 'src_ctx', into 'ctx'. Numbers, strings,
+   arrays and plain objects (own properties only) are copied; an object
+   or string reached several times is copied once, so cycles and shared
+   references are kept. Other values throw a TypeError in 'ctx'.
+   'src_ctx' is only read and must not run or allocate meanwhile. */
+JSValue JS_CloneValue(JSContext *ctx, JSContext *src_ctx, JSValue val);
 /* create a C function with an object parameter (closure) */
 JSValue JS_NewCFunctionParams(JSContext *ctx, int func_idx, JSValue params);
 
@@ -297,9 +344,47 @@ JSValue JS_NewCFunctionParams(JSContext *ctx, int func_idx, JSValue params);
 JSValue JS_Parse(JSContext *ctx, const char *input, size_t input_len,
                  const char *filename, int eval_flags);
 JSValue JS_Run(JSContext *ctx, JSValue val);
+/* TRUE if the last JS_Run() or JS_Resume() returned because the
+   interrupt handler asked to suspend. Suspension only happens at
+   backward jumps of JS functions called directly by JS_Run() (not
+   from C functions), and the frames stay on the context stack. */
+JS_BOOL JS_IsSuspended(JSContext *ctx);
+/* continue a suspended run. Returns its result, or JS_UNDEFINED if it
+   is suspended again. If abort is TRUE, the run is stopped with an
+   uncatchable "interrupted" error instead. */
+JSValue JS_Resume(JSContext *ctx, JS_BOOL abort);
 JSValue JS_Eval(JSContext *ctx, const char *input, size_t input_len,
                 const char *filename, int eval_flags);
 void JS_GC(JSContext *ctx);
+
+/* heap introspection */
+typedef struct {
+    uint32_t offset; /* from the start of the heap, identifies the block */
+    uint32_t size; /* in bytes, including the header */
+    int mtag; /* JS_MTAG_x, see JS_GetMTagName() */
+    int class_id; /* JS_CLASS_x for objects, -1 otherwise */
+} JSHeapBlock;
+
+#define JS_HEAP_ROOT 0xffffffff /* 'from' offset of the references held by GC roots */
+
+typedef void JSHeapBlockFunc(void *opaque, const JSHeapBlock *block);
+/* reference from the block at offset 'from' to the block at offset 'to' */
+typedef void JSHeapEdgeFunc(void *opaque, uint32_t from, uint32_t to);
+/* call 'block_func' for each memory block in address order and
+   'edge_func' for each reference between blocks, then for each root
+   reference. Either function may be NULL. No JS value may be
+   allocated from them. */
+void JS_WalkHeap(JSContext *ctx, JSHeapBlockFunc *block_func,
+                 JSHeapEdgeFunc *edge_func, void *opaque);
+
+typedef struct {
+    size_t heap_size; /* allocated heap, including free blocks */
+    size_t stack_size;
+    size_t total_size; /* memory available for the heap and the stack */
+} JSMemoryUsage;
+void JS_GetMemoryUsage(JSContext *ctx, JSMemoryUsage *usage);
+/* return NULL if 'mtag' is invalid */
+const char *JS_GetMTagName(int mtag);
 JSValue JS_NewStringLen(JSContext *ctx, const char *buf, size_t buf_len);
 JSValue JS_NewString(JSContext *ctx, const char *buf);
 const char *JS_ToCStringLen(JSContext *ctx, size_t *plen, JSValue val, JSCStringBuf *buf);
@@ -311,6 +396,56 @@ int JS_ToInt32Sat(JSContext *ctx, int *pres, JSValue val);
 int JS_ToNumber(JSContext *ctx, double *pres, JSValue val);
 
 JSValue JS_GetException(JSContext *ctx);
+
+/* stack introspection */
+typedef struct {
+    const char *func_name; /* NULL if anonymous */
+    const char *filename; /* NULL for C functions */
+    int line_num; /* 0 if unknown */
+    int col_num; /* 0 if unknown */
+} JSStackFrame;
+
+/* return != 0 to stop the walk. The strings are only valid during the
+   call and no JS value may be allocated from it. */
+typedef int JSStackFrameFunc(void *opaque, const JSStackFrame *frame);
+/* call 'func' for each active frame, innermost first. Return the
+   number of visited frames. */
+int JS_WalkStack(JSContext *ctx, JSStackFrameFunc *func, void *opaque,
+                 int max_levels);
+
+/* opcode statistics (only counted if compiled with JS_OPCODE_STATS) */
+typedef enum {
+    JS_SLOW_PATH_ADD,
+    JS_SLOW_PATH_BINARY_ARITH,
+    JS_SLOW_PATH_UNARY_ARITH,
+    JS_SLOW_PATH_POST_INC_DEC,
+    JS_SLOW_PATH_BINARY_LOGIC,
+    JS_SLOW_PATH_NOT,
+    JS_SLOW_PATH_RELATIONAL,
+    JS_SLOW_PATH_EQ,
+    JS_SLOW_PATH_STRICT_EQ,
+    JS_SLOW_PATH_GET_FIELD,
+    JS_SLOW_PATH_GET_LENGTH,
+    JS_SLOW_PATH_PUT_FIELD,
+    JS_SLOW_PATH_GET_ARRAY_EL,
+    JS_SLOW_PATH_PUT_ARRAY_EL,
+    JS_SLOW_PATH_COUNT,
+} JSSlowPathEnum;
+
+typedef struct {
+    uint64_t *op_count; /* JS_GetOpcodeCount() elements */
+    uint64_t *op_pair_count; /* JS_GetOpcodeCount()^2 elements indexed by
+                                prev_op * JS_GetOpcodeCount() + op, or NULL */
+    uint64_t slow_path_count[JS_SLOW_PATH_COUNT];
+} JSOpcodeStats;
+
+/* start counting into 'stats' (NULL = stop). The counters are only
+   incremented. Return -1 if opcode statistics are not compiled in. */
+int JS_SetOpcodeStats(JSContext *ctx, JSOpcodeStats *stats);
+int JS_GetOpcodeCount(void);
+/* return NULL if 'op' is invalid or if the statistics are not compiled in */
+const char *JS_GetOpcodeName(int op);
+const char *JS_GetSlowPathName(int idx);
 int JS_StackCheck(JSContext *ctx, uint32_t len);
 void JS_PushArg(JSContext *ctx, JSValue val);
 #define FRAME_CF_CTOR           (1 << 16) /* also ored with argc in
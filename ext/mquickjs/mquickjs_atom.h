@@ -0,0 +1,76 @@
+#define JS_ATOM_null 0
+#define JS_ATOM_false 2
+#define JS_ATOM_true 4
+#define JS_ATOM_if 6
+#define JS_ATOM_else 8
+#define JS_ATOM_return 10
+#define JS_ATOM_var 12
+#define JS_ATOM_this 14
+#define JS_ATOM_delete 16
+#define JS_ATOM_void 18
+#define JS_ATOM_typeof 20
+#define JS_ATOM_new 22
+#define JS_ATOM_in 24
+#define JS_ATOM_instanceof 26
+#define JS_ATOM_do 29
+#define JS_ATOM_while 31
+#define JS_ATOM_for 33
+#define JS_ATOM_break 35
+#define JS_ATOM_continue 37
+#define JS_ATOM_switch 40
+#define JS_ATOM_case 42
+#define JS_ATOM_default 44
+#define JS_ATOM_throw 46
+#define JS_ATOM_try 48
+#define JS_ATOM_catch 50
+#define JS_ATOM_finally 52
+#define JS_ATOM_function 54
+#define JS_ATOM_debugger 57
+#define JS_ATOM_with 60
+#define JS_ATOM_class 62
+#define JS_ATOM_const 64
+#define JS_ATOM_enum 66
+#define JS_ATOM_export 68
+#define JS_ATOM_extends 70
+#define JS_ATOM_import 72
+#define JS_ATOM_super 74
+#define JS_ATOM_implements 76
+#define JS_ATOM_interface 79
+#define JS_ATOM_let 82
+#define JS_ATOM_package 84
+#define JS_ATOM_private 86
+#define JS_ATOM_protected 88
+#define JS_ATOM_public 91
+#define JS_ATOM_static 93
+#define JS_ATOM_yield 95
+#define JS_ATOM_empty 97
+#define JS_ATOM_toString 99
+#define JS_ATOM_valueOf 102
+#define JS_ATOM_number 104
+#define JS_ATOM_object 106
+#define JS_ATOM_undefined 108
+#define JS_ATOM_string 111
+#define JS_ATOM_boolean 113
+#define JS_ATOM__ret_ 115
+#define JS_ATOM__eval_ 117
+#define JS_ATOM_eval 119
+#define JS_ATOM_arguments 121
+#define JS_ATOM_value 124
+#define JS_ATOM_get 126
+#define JS_ATOM_set 128
+#define JS_ATOM_prototype 130
+#define JS_ATOM_constructor 133
+#define JS_ATOM_length 136
+#define JS_ATOM_target 138
+#define JS_ATOM_of 140
+#define JS_ATOM_NaN 142
+#define JS_ATOM_Infinity 144
+#define JS_ATOM__Infinity 147
+#define JS_ATOM_name 150
+#define JS_ATOM_Error 152
+#define JS_ATOM___proto__ 154
+#define JS_ATOM_index 157
+#define JS_ATOM_input 159
+
+#define JS_ATOM_END 161
+
@@ -377,12 +377,12 @@ static uint32_t dump_atom(BuildContext *s, const char *str, BOOL value_only)
     return 0;
 }
 
-static void dump_cfuncs(BuildContext *s)
+static void dump_cfuncs(BuildContext *s, const char *stdlib_name)
 {
     int i;
     CFuncDef *e;
     
-    printf("static const JSCFunctionDef js_c_function_table[] = {\n");
+    printf("static const JSCFunctionDef %s_c_function_table[] = {\n", stdlib_name);
     for(i = 0; i < s->cfunc_list.count; i++) {
         e = &s->cfunc_list.tab[i];
         printf("  { { .%s = %s },\n", e->cproto_name, e->cfunc_name);
@@ -395,12 +395,12 @@ static void dump_cfuncs(BuildContext *s)
     printf("};\n\n");
 }
 
-static void dump_cfinalizers(BuildContext *s)
+static void dump_cfinalizers(BuildContext *s, const char *stdlib_name)
 {
     struct list_head *el;
     ClassDefEntry *e;
     
-    printf("static const JSCFinalizer js_c_finalizer_table[JS_CLASS_COUNT - JS_CLASS_USER] = {\n");
+    printf("static const JSCFinalizer %s_c_finalizer_table[JS_CLASS_COUNT - JS_CLASS_USER] = {\n", stdlib_name);
     list_for_each(el, &s->class_list) {
         e = list_entry(el, ClassDefEntry, link);
         if (e->finalizer_name &&
@@ -820,17 +820,113 @@ static void define_atoms_props(BuildContext *s, const JSPropDef *props_def, JSPr
 
 static int usage(const char *name)
 {
-    fprintf(stderr, "usage: %s {-m32 | -m64} [-a]\n", name);
+    fprintf(stderr, "usage: %s {-m32 | -m64} [-a] [-n name] [-p profile]\n", name);
     fprintf(stderr,
             "    create a ROM file for the mquickjs standard library\n"
             "--help       list options\n"
             "-m32         force generation for a 32 bit target\n"
             "-m64         force generation for a 64 bit target\n"
             "-a           generate the mquickjs_atom.h header\n"
+            "-n name      name of the generated JSSTDLibraryDef and prefix of its tables\n"
+            "-p profile   only include the global object properties listed in\n"
+            "             the 'profile' file (one name per line, '#' starts a comment)\n"
             );
     return 1;
 }
 
+/* Global object properties the engine itself relies on: it creates
+   instances of these classes and throws these errors without looking
+   them up, so a profile cannot leave them out. The parser accepts regexp
+   literals in every profile, so RegExp is required too. */
+static const char *profile_required_props[] = {
+    "Object", "Function", "Number", "Boolean", "String", "Array", "RegExp",
+    "Error", "EvalError", "RangeError", "ReferenceError", "SyntaxError",
+    "TypeError", "URIError", "InternalError",
+};
+
+static BOOL profile_has_name(char **names, int count, const char *name)
+{
+    int i;
+    for(i = 0; i < count; i++) {
+        if (!strcmp(names[i], name))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/* Return a copy of 'global_obj' restricted to the properties listed in
+   the profile file, plus the required ones. Exit on error. */
+static JSPropDef *load_profile(const char *filename, const JSPropDef *global_obj)
+{
+    FILE *f;
+    char line[256], **names;
+    int count, size, i, n;
+    const JSPropDef *d;
+    JSPropDef *props;
+
+    f = fopen(filename, "r");
+    if (!f) {
+        perror(filename);
+        exit(1);
+    }
+    names = NULL;
+    count = 0;
+    size = 0;
+    while (fgets(line, sizeof(line), f)) {
+        char *p, *end;
+        p = strchr(line, '#');
+        if (p)
+            *p = '\0';
+        p = line;
+        while (isspace((unsigned char)*p))
+            p++;
+        end = p + strlen(p);
+        while (end > p && isspace((unsigned char)end[-1]))
+            end--;
+        *end = '\0';
+        if (*p == '\0')
+            continue;
+        for(d = global_obj; d->def_type != JS_DEF_END; d++) {
+            if (!strcmp(d->name, p))
+                break;
+        }
+        if (d->def_type == JS_DEF_END) {
+            fprintf(stderr, "%s: '%s' is not a global object property\n", filename, p);
+            exit(1);
+        }
+        if (count >= size) {
+            size = max_int(size * 2, 16);
+            names = realloc(names, sizeof(names[0]) * size);
+        }
+        names[count++] = strdup(p);
+    }
+    fclose(f);
+
+    for(i = 0; i < (int)countof(profile_required_props); i++) {
+        if (!profile_has_name(names, count, profile_required_props[i])) {
+            fprintf(stderr, "%s: '%s' is required by the engine\n",
+                    filename, profile_required_props[i]);
+            exit(1);
+        }
+    }
+
+    n = 0;
+    for(d = global_obj; d->def_type != JS_DEF_END; d++)
+        n++;
+    props = malloc(sizeof(props[0]) * (n + 1));
+    n = 0;
+    for(d = global_obj; d->def_type != JS_DEF_END; d++) {
+        if (profile_has_name(names, count, d->name))
+            props[n++] = *d;
+    }
+    props[n] = *d; /* JS_PROP_END */
+
+    for(i = 0; i < count; i++)
+        free(names[i]);
+    free(names);
+    return props;
+}
+
 int build_atoms(const char *stdlib_name, const JSPropDef *global_obj,
                 const JSPropDef *c_function_decl, int argc, char **argv)
 {
@@ -838,6 +934,7 @@ int build_atoms(const char *stdlib_name, const JSPropDef *global_obj,
     unsigned jsw;
     BuildContext ss, *s = &ss;
     BOOL build_atom_defines = FALSE;
+    const char *profile_filename = NULL;
     
 #if INTPTR_MAX >= INT64_MAX
     jsw = 8;
@@ -851,6 +948,10 @@ int build_atoms(const char *stdlib_name, const JSPropDef *global_obj,
             jsw = 4;
         } else if (!strcmp(argv[i], "-a")) {
             build_atom_defines = TRUE;
+        } else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            stdlib_name = argv[++i];
+        } else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+            profile_filename = argv[++i];
         } else if (!strcmp(argv[i], "--help")) {
             return usage(argv[0]);
         } else {
@@ -866,6 +967,9 @@ int build_atoms(const char *stdlib_name, const JSPropDef *global_obj,
         return 0;
     }
     
+    if (profile_filename)
+        global_obj = load_profile(profile_filename, global_obj);
+
     memset(s, 0, sizeof(*s));
     init_list_head(&s->class_list);
 
@@ -898,9 +1002,15 @@ int build_atoms(const char *stdlib_name, const JSPropDef *global_obj,
 
     printf("/* this file is automatically generated - do not edit */\n\n");
     printf("#include \"mquickjs_priv.h\"\n\n");
+    /* JS_ROM_VALUE() refers to js_stdlib_table, point it at this table */
+    if (strcmp(stdlib_name, "js_stdlib") != 0) {
+        printf("#undef JS_ROM_VALUE\n");
+        printf("#define JS_ROM_VALUE(offset) JS_VALUE_FROM_PTR(&%s_table[offset])\n\n",
+               stdlib_name);
+    }
     
-    printf("static const uint%u_t __attribute((aligned(%d))) js_stdlib_table[] = {\n",
-           JSW * 8, ATOM_ALIGN);
+    printf("static const uint%u_t __attribute((aligned(%d))) %s_table[] = {\n",
+           JSW * 8, ATOM_ALIGN, stdlib_name);
 
     dump_atoms(s);
 
@@ -908,20 +1018,20 @@ int build_atoms(const char *stdlib_name, const JSPropDef *global_obj,
 
     printf("};\n\n");
 
-    dump_cfuncs(s);
+    dump_cfuncs(s, stdlib_name);
     
     printf("#ifndef JS_CLASS_COUNT\n"
            "#define JS_CLASS_COUNT JS_CLASS_USER /* total number of classes */\n"
            "#endif\n\n");
 
-    dump_cfinalizers(s);
+    dump_cfinalizers(s, stdlib_name);
 
     free_class_entries(s);
 
     printf("const JSSTDLibraryDef %s = {\n", stdlib_name);
-    printf("  js_stdlib_table,\n");
-    printf("  js_c_function_table,\n");
-    printf("  js_c_finalizer_table,\n");
+    printf("  %s_table,\n", stdlib_name);
+    printf("  %s_c_function_table,\n", stdlib_name);
+    printf("  %s_c_finalizer_table,\n", stdlib_name);
     printf("  %d,\n", s->cur_offset);
     printf("  %d,\n", ATOM_ALIGN);
     printf("  %d,\n", s->sorted_atom_table_offset);
@@ -929,5 +1039,10 @@ int build_atoms(const char *stdlib_name, const JSPropDef *global_obj,
     printf("  JS_CLASS_COUNT,\n");
     printf("};\n\n");
 
+    if (strcmp(stdlib_name, "js_stdlib") != 0) {
+        printf("#undef JS_ROM_VALUE\n");
+        printf("#define JS_ROM_VALUE(offset) JS_VALUE_FROM_PTR(&js_stdlib_table[offset])\n");
+    }
+
     return 0;
 }
@@ -5,9 +5,13 @@
 
 #include <ruby.h>
 #include <ruby/encoding.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <sys/mman.h>
 #include <sys/time.h>
 
 // Include mquickjs after defining stub functions
@@ -18,11 +22,35 @@ static VALUE rb_eMQuickJSSyntaxError;
 static VALUE rb_eMQuickJSJavascriptError;
 static VALUE rb_eMQuickJSMemoryLimitError;
 static VALUE rb_eMQuickJSTimeoutError;
+static VALUE rb_cPrelude;
 
 // Forward declarations
 typedef struct JSContext JSContext;
 typedef uint64_t JSValue;
 
+// A prelude compiled once into relocated bytecode. The image is mapped
+// read-only and shared by every sandbox it is attached to, which keeps a
+// reference so the image outlives the NativePrelude that compiled it.
+typedef struct {
+    uint8_t *image;
+    size_t image_size;
+    int refcount;
+    int stdlib_profile;  // Index in js_stdlib_profiles the image was relocated for
+} PreludeImage;
+
+// Per-eval timing breakdown, in nanoseconds. GC and host callback time
+// is also included in the parse/run phase it happened in.
+typedef struct {
+    int64_t parse_ns;
+    int64_t run_ns;
+    int64_t convert_ns;
+    int64_t gc_ns;
+    int64_t gc_max_ns;
+    int64_t host_ns;
+    int gc_count;
+    int host_calls;
+} EvalTimings;
+
 // Context wrapper structure
 typedef struct {
     JSContext *ctx;
@@ -37,11 +65,29 @@ typedef struct {
     size_t console_max_size;
     int console_truncated;
     VALUE rb_http_callback;  // Ruby callback for HTTP requests
+    int profiling;  // Sampling profiler enabled
+    int64_t profile_interval_ns;
+    int64_t profile_next_sample_ns;
+    VALUE rb_profile_samples;  // Collapsed stack => sample count
+    VALUE rb_alloc_samples;  // [site, mtag] => sample count, while sampling allocations
+    struct JSOpcodeStatsBuf *opcode_stats;  // Non-NULL while counting opcodes
+    int collect_timings;  // Fill in Result#timings
+    EvalTimings timings;
+    int64_t eval_start_ns;
+    int64_t gc_start_ns;
+    size_t peak_heap_size;  // Heap high-water mark, sampled before each GC
+    int64_t arena_alloc_ns;  // Sandbox creation: malloc of the arena
+    int64_t new_context_ns;  // Sandbox creation: JS_NewContext and stdlib setup
+    int64_t slice_deadline_ns;  // Suspend at the next loop iteration after this, 0 = never
+    int64_t suspended_at_ns;  // When the current eval was suspended
+    int running;  // JavaScript is executing, possibly waiting in a host callback
+    VALUE rb_host_error;  // Exception from a host callback, raised once the run has unwound
+    int impure;  // The current eval called Date.now, performance.now, Math.random or fetch
+    PreludeImage *prelude;  // Attached prelude, its bytecode registered as a ROM atom table
+    int stdlib_profile;  // Index in js_stdlib_profiles
+    int symbolize_keys;  // Result hashes get Symbol keys
 } ContextWrapper;
 
-// Thread-local storage for current wrapper
-static __thread ContextWrapper *current_wrapper = NULL;
-
 // Stub functions required by mqjs_stdlib.h
 static void append_console_output(ContextWrapper *wrapper, const char *str, size_t len);
 
@@ -51,15 +97,33 @@ static JSValue js_print(JSContext *ctx, JSValue *this_val, int argc, JSValue *ar
 static JSValue js_gc(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
 static JSValue js_date_now(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
 static JSValue js_performance_now(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
+static JSValue js_sandbox_math_random(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
 static JSValue js_load(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
 static JSValue js_setTimeout(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
 static JSValue js_clearTimeout(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
 static JSValue js_fetch(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv);
 
-// Include the standard library
+// Include the standard library and its build profiles
 #include "mqjs_stdlib.h"
+#include "mqjs_stdlib_profiles.h"
 #include "mquickjs_priv.h"
 
+#define STDLIB_PROFILE_COUNT ((int)(sizeof(js_stdlib_profiles) / sizeof(js_stdlib_profiles[0])))
+
+// Index of the stdlib profile called name (String or Symbol)
+static int stdlib_profile_index(VALUE name) {
+    if (SYMBOL_P(name)) {
+        name = rb_sym2str(name);
+    }
+    const char *str = StringValueCStr(name);
+    for (int i = 0; i < STDLIB_PROFILE_COUNT; i++) {
+        if (strcmp(js_stdlib_profiles[i].name, str) == 0) {
+            return i;
+        }
+    }
+    rb_raise(rb_eArgError, "Unknown stdlib profile '%s'", str);
+}
+
 // Get current time in milliseconds
 static int64_t get_time_ms(void) {
     struct timespec ts;
@@ -67,10 +131,289 @@ static int64_t get_time_ms(void) {
     return (int64_t)ts.tv_sec * 1000 + (ts.tv_nsec / 1000000);
 }
 
-// Interrupt handler for timeout
+// Get current time in nanoseconds
+static int64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// Process-wide metrics (MQuickJS.metrics)
+//
+// Every thread updates its own shard with plain relaxed stores, so the hot
+// path takes no lock and no atomic read-modify-write. Shards are linked into
+// a global list and never freed; the shard of an exited thread is handed to
+// the next new thread. Snapshots sum all shards and subtract the baseline
+// recorded by the last reset, so resetting never races with an update.
+enum {
+    METRIC_EVALS,
+    METRIC_SYNTAX_ERRORS,
+    METRIC_JAVASCRIPT_ERRORS,
+    METRIC_TIMEOUTS,
+    METRIC_MEMORY_LIMIT_ERRORS,
+    METRIC_FETCH_ERRORS,
+    METRIC_GC_RUNS,
+    METRIC_BYTES_CONVERTED,
+    METRIC_FETCH_REQUESTS,
+    METRIC_COUNT
+};
+
+static const char *const metric_names[METRIC_COUNT] = {
+    "evals",
+    "syntax_errors",
+    "javascript_errors",
+    "timeouts",
+    "memory_limit_errors",
+    "fetch_errors",
+    "gc_runs",
+    "bytes_converted",
+    "fetch_requests",
+};
+
+enum {
+    HISTOGRAM_EVAL_DURATION,
+    HISTOGRAM_GC_DURATION,
+    HISTOGRAM_COUNT
+};
+
+static const char *const histogram_names[HISTOGRAM_COUNT] = {
+    "eval_duration_seconds",
+    "gc_duration_seconds",
+};
+
+// Upper bounds of the duration buckets, plus an implicit +Inf bucket
+#define METRICS_BUCKET_COUNT 17
+static const int64_t metrics_bucket_bounds_ns[METRICS_BUCKET_COUNT] = {
+    50000, 100000, 250000, 500000,
+    1000000, 2500000, 5000000, 10000000, 25000000, 50000000,
+    100000000, 250000000, 500000000,
+    1000000000, 2500000000LL, 5000000000LL, 10000000000LL,
+};
+
+typedef struct MetricsShard {
+    uint64_t counters[METRIC_COUNT];
+    uint64_t buckets[HISTOGRAM_COUNT][METRICS_BUCKET_COUNT + 1];
+    uint64_t sums_ns[HISTOGRAM_COUNT];
+    int in_use;
+    struct MetricsShard *next;
+} MetricsShard;
+
+static MetricsShard *metrics_shards = NULL;
+static __thread MetricsShard *metrics_shard = NULL;
+static pthread_key_t metrics_shard_key;
+static pthread_mutex_t metrics_reset_lock = PTHREAD_MUTEX_INITIALIZER;
+static MetricsShard metrics_baseline;
+
+static void metrics_release_shard(void *ptr) {
+    __atomic_store_n(&((MetricsShard *)ptr)->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static MetricsShard *metrics_get_shard(void) {
+    MetricsShard *shard = metrics_shard;
+    if (shard) return shard;
+
+    // Reuse the shard of an exited thread
+    for (shard = __atomic_load_n(&metrics_shards, __ATOMIC_ACQUIRE); shard; shard = shard->next) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&shard->in_use, &expected, 1, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    if (!shard) {
+        shard = calloc(1, sizeof(MetricsShard));
+        if (!shard) return NULL;
+        shard->in_use = 1;
+        shard->next = __atomic_load_n(&metrics_shards, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&metrics_shards, &shard->next, shard, 1,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        }
+    }
+
+    metrics_shard = shard;
+    pthread_setspecific(metrics_shard_key, shard);
+    return shard;
+}
+
+// Only the owning thread writes a shard, so load + store is enough
+static inline void metrics_bump(uint64_t *counter, uint64_t n) {
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + n, __ATOMIC_RELAXED);
+}
+
+static void metrics_add(int metric, uint64_t n) {
+    MetricsShard *shard = metrics_get_shard();
+    if (shard) metrics_bump(&shard->counters[metric], n);
+}
+
+static void metrics_observe(int histogram, int64_t duration_ns) {
+    MetricsShard *shard = metrics_get_shard();
+    if (!shard) return;
+
+    int bucket = 0;
+    while (bucket < METRICS_BUCKET_COUNT && duration_ns > metrics_bucket_bounds_ns[bucket]) {
+        bucket++;
+    }
+    metrics_bump(&shard->buckets[histogram][bucket], 1);
+    metrics_bump(&shard->sums_ns[histogram], (uint64_t)duration_ns);
+}
+
+// Sum of all shards
+static void metrics_collect(MetricsShard *total) {
+    memset(total, 0, sizeof(MetricsShard));
+    MetricsShard *shard = __atomic_load_n(&metrics_shards, __ATOMIC_ACQUIRE);
+    for (; shard; shard = shard->next) {
+        for (int i = 0; i < METRIC_COUNT; i++) {
+            total->counters[i] += __atomic_load_n(&shard->counters[i], __ATOMIC_RELAXED);
+        }
+        for (int h = 0; h < HISTOGRAM_COUNT; h++) {
+            for (int b = 0; b <= METRICS_BUCKET_COUNT; b++) {
+                total->buckets[h][b] += __atomic_load_n(&shard->buckets[h][b], __ATOMIC_RELAXED);
+            }
+            total->sums_ns[h] += __atomic_load_n(&shard->sums_ns[h], __ATOMIC_RELAXED);
+        }
+    }
+}
+
+// Interrupt polls between two profiler clock checks while profiling
+#define PROFILE_INTERRUPT_PERIOD 1000
+#define PROFILE_MAX_FRAMES 64
+#define PROFILE_LABELS_SIZE 4096
+
+// Frame labels of one sample, innermost first
+struct profile_walk {
+    char labels[PROFILE_LABELS_SIZE];
+    size_t labels_len;
+    size_t offsets[PROFILE_MAX_FRAMES];
+    int count;
+};
+
+static int profile_frame_cb(void *opaque, const JSStackFrame *frame) {
+    struct profile_walk *walk = (struct profile_walk *)opaque;
+    char *dst = walk->labels + walk->labels_len;
+    size_t available = sizeof(walk->labels) - walk->labels_len;
+    const char *name = frame->func_name ? frame->func_name : "<anonymous>";
+    int n;
+
+    if (frame->filename) {
+        n = snprintf(dst, available, "%s (%s:%d)", name, frame->filename, frame->line_num);
+    } else {
+        n = snprintf(dst, available, "%s (native)", name);
+    }
+
+    // Out of room: keep the innermost frames collected so far
+    if (n < 0 || (size_t)n >= available) return 1;
+
+    walk->offsets[walk->count++] = walk->labels_len;
+    walk->labels_len += n + 1;
+    return walk->count >= PROFILE_MAX_FRAMES;
+}
+
+// Record the current JS stack as one collapsed (flamegraph) line
+static void profile_take_sample(ContextWrapper *wrapper, JSContext *ctx) {
+    struct profile_walk walk;
+    walk.labels_len = 0;
+    walk.count = 0;
+
+    JS_WalkStack(ctx, profile_frame_cb, &walk, PROFILE_MAX_FRAMES);
+    if (walk.count == 0) return;
+
+    // Collapsed stacks list the outermost frame first
+    VALUE stack = rb_enc_str_new(NULL, 0, rb_utf8_encoding());
+    for (int i = walk.count - 1; i >= 0; i--) {
+        rb_str_cat_cstr(stack, walk.labels + walk.offsets[i]);
+        if (i > 0) rb_str_cat(stack, ";", 1);
+    }
+
+    VALUE count = rb_hash_lookup2(wrapper->rb_profile_samples, stack, INT2FIX(0));
+    rb_hash_aset(wrapper->rb_profile_samples, stack, LONG2FIX(FIX2LONG(count) + 1));
+}
+
+// Allocation sampling: attribute each sample to the innermost JavaScript
+// frame, so allocations made by native functions count at their call site
+#define ALLOC_SITE_SIZE 256
+
+static int alloc_site_frame_cb(void *opaque, const JSStackFrame *frame) {
+    if (!frame->filename) return 0;
+    snprintf((char *)opaque, ALLOC_SITE_SIZE, "%s (%s:%d)",
+             frame->func_name ? frame->func_name : "<anonymous>",
+             frame->filename, frame->line_num);
+    return 1;
+}
+
+static void alloc_sample_hook(JSContext *ctx, void *opaque, uint32_t size, int mtag, uint32_t samples) {
+    ContextWrapper *wrapper = (ContextWrapper *)opaque;
+    char site[ALLOC_SITE_SIZE];
+
+    // No JavaScript frame: compiling, or converting values from Ruby
+    strcpy(site, "(no JavaScript frame)");
+    JS_WalkStack(ctx, alloc_site_frame_cb, site, PROFILE_MAX_FRAMES);
+
+    VALUE key = rb_ary_new_from_args(2, rb_utf8_str_new_cstr(site), rb_str_new_cstr(JS_GetMTagName(mtag)));
+    VALUE count = rb_hash_lookup2(wrapper->rb_alloc_samples, key, INT2FIX(0));
+    rb_hash_aset(wrapper->rb_alloc_samples, key, LONG2FIX(FIX2LONG(count) + samples));
+}
+
+// Count a finished eval; error_metric is -1 on success
+static void metrics_record_eval(ContextWrapper *wrapper, int error_metric) {
+    metrics_add(METRIC_EVALS, 1);
+    if (error_metric >= 0) {
+        metrics_add(error_metric, 1);
+    }
+    metrics_observe(HISTOGRAM_EVAL_DURATION, get_time_ns() - wrapper->eval_start_ns);
+}
+
+// GC hook for metrics and timings
+static void gc_hook(JSContext *ctx, void *opaque, JS_BOOL done) {
+    ContextWrapper *wrapper = (ContextWrapper *)opaque;
+    if (!done) {
+        // The heap only grows between collections, so its size right
+        // before one is the peak since the previous one
+        JSMemoryUsage usage;
+        JS_GetMemoryUsage(ctx, &usage);
+        if (usage.heap_size > wrapper->peak_heap_size) {
+            wrapper->peak_heap_size = usage.heap_size;
+        }
+        wrapper->gc_start_ns = get_time_ns();
+        return;
+    }
+
+    int64_t duration_ns = get_time_ns() - wrapper->gc_start_ns;
+    metrics_add(METRIC_GC_RUNS, 1);
+    metrics_observe(HISTOGRAM_GC_DURATION, duration_ns);
+    if (wrapper->collect_timings) {
+        wrapper->timings.gc_ns += duration_ns;
+        wrapper->timings.gc_count++;
+        if (duration_ns > wrapper->timings.gc_max_ns) {
+            wrapper->timings.gc_max_ns = duration_ns;
+        }
+    }
+}
+
+// Host callback timing (console, fetch)
+static inline int64_t host_call_begin(ContextWrapper *wrapper) {
+    return wrapper->collect_timings ? get_time_ns() : 0;
+}
+
+static inline void host_call_end(ContextWrapper *wrapper, int64_t start_ns) {
+    if (wrapper->collect_timings) {
+        wrapper->timings.host_ns += get_time_ns() - start_ns;
+        wrapper->timings.host_calls++;
+    }
+}
+
+// Interrupt handler for timeout and profiling
 static int interrupt_handler(JSContext *ctx, void *opaque) {
     ContextWrapper *wrapper = (ContextWrapper *)opaque;
 
+    if (wrapper->profiling) {
+        int64_t now = get_time_ns();
+        if (now >= wrapper->profile_next_sample_ns) {
+            profile_take_sample(wrapper, ctx);
+            wrapper->profile_next_sample_ns = now + wrapper->profile_interval_ns;
+        }
+    }
+
     if (wrapper->timeout_ms > 0) {
         int64_t elapsed = get_time_ms() - wrapper->start_time_ms;
         if (elapsed > wrapper->timeout_ms) {
@@ -79,6 +422,10 @@ static int interrupt_handler(JSContext *ctx, void *opaque) {
         }
     }
 
+    if (wrapper->slice_deadline_ns > 0 && get_time_ns() >= wrapper->slice_deadline_ns) {
+        return JS_INTERRUPT_SUSPEND;  // Hand control back to Ruby until Sandbox#resume
+    }
+
     return 0;  // Continue execution
 }
 
@@ -127,9 +474,10 @@ static void append_console_output(ContextWrapper *wrapper, const char *str, size
 
 // Stub function implementations
 static JSValue js_print(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
-    ContextWrapper *wrapper = current_wrapper;
+    ContextWrapper *wrapper = JS_GetContextOpaque(ctx);
     if (!wrapper) return JS_UNDEFINED;
 
+    int64_t host_start_ns = host_call_begin(wrapper);
     JSCStringBuf buf;
     for (int i = 0; i < argc; i++) {
         if (i > 0) {
@@ -155,6 +503,7 @@ static JSValue js_print(JSContext *ctx, JSValue *this_val, int argc, JSValue *ar
         }
     }
     append_console_output(wrapper, "\n", 1);
+    host_call_end(wrapper, host_start_ns);
 
     return JS_UNDEFINED;
 }
@@ -164,19 +513,36 @@ static JSValue js_gc(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv)
     return JS_UNDEFINED;
 }
 
+// Record that the current eval's result depends on more than its code and
+// inputs, so Sandbox memoization must not cache it
+static void mark_impure(JSContext *ctx) {
+    ContextWrapper *wrapper = JS_GetContextOpaque(ctx);
+    if (wrapper) {
+        wrapper->impure = 1;
+    }
+}
+
 static JSValue js_date_now(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    mark_impure(ctx);
     struct timeval tv;
     gettimeofday(&tv, NULL);
     return JS_NewInt64(ctx, (int64_t)tv.tv_sec * 1000 + (tv.tv_usec / 1000));
 }
 
 static JSValue js_performance_now(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    mark_impure(ctx);
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
     int64_t ms = (int64_t)ts.tv_sec * 1000 + (ts.tv_nsec / 1000000);
     return JS_NewInt64(ctx, ms);
 }
 
+// Math.random: the engine's generator, flagged as impure
+static JSValue js_sandbox_math_random(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
+    mark_impure(ctx);
+    return js_math_random(ctx, this_val, argc, argv);
+}
+
 static JSValue js_load(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
     return JS_ThrowError(ctx, JS_CLASS_ERROR, "load() is disabled in sandbox mode");
 }
@@ -215,6 +581,8 @@ static void reraise_http_error_with_console(ContextWrapper *wrapper, VALUE excep
     VALUE exc_class = rb_obj_class(exception);
     VALUE message = rb_funcall(exception, rb_intern("message"), 0);
 
+    metrics_record_eval(wrapper, METRIC_FETCH_ERRORS);
+
     // Create console output strings
     VALUE console_output = rb_str_new(wrapper->console_output, wrapper->console_output_len);
     VALUE console_truncated = wrapper->console_truncated ? Qtrue : Qfalse;
@@ -235,10 +603,11 @@ static void reraise_http_error_with_console(ContextWrapper *wrapper, VALUE excep
 
 // fetch() implementation
 static JSValue js_fetch(JSContext *ctx, JSValue *this_val, int argc, JSValue *argv) {
-    ContextWrapper *wrapper = current_wrapper;
+    ContextWrapper *wrapper = JS_GetContextOpaque(ctx);
     if (!wrapper) {
         return JS_ThrowError(ctx, JS_CLASS_ERROR, "fetch() called outside sandbox context");
     }
+    wrapper->impure = 1;
 
     if (wrapper->rb_http_callback == Qnil) {
         return JS_ThrowError(ctx, JS_CLASS_ERROR, "fetch() is not enabled - HTTP callback not configured");
@@ -284,6 +653,7 @@ static JSValue js_fetch(JSContext *ctx, JSValue *this_val, int argc, JSValue *ar
     }
 
     // Call Ruby HTTP executor with exception protection
+    metrics_add(METRIC_FETCH_REQUESTS, 1);
     VALUE rb_url = rb_str_new2(url);
     VALUE rb_method = rb_str_new2(method);
     VALUE rb_body = body ? rb_str_new2(body) : Qnil;
@@ -296,16 +666,22 @@ static JSValue js_fetch(JSContext *ctx, JSValue *this_val, int argc, JSValue *ar
         .headers = rb_headers
     };
 
+    // The callback runs on the calling fiber. Under a Fiber.scheduler its
+    // I/O waits switch to other fibers, which can run other sandboxes;
+    // this one stays marked as running until the eval returns.
     int state = 0;
+    int64_t host_start_ns = host_call_begin(wrapper);
     VALUE rb_response = rb_protect(http_callback_wrapper, (VALUE)&args, &state);
+    host_call_end(wrapper, host_start_ns);
 
-    // Check if an exception was raised
+    // Check if an exception was raised. Raising it here would jump over
+    // the interpreter's frames, so unwind them with an uncatchable error
+    // first and raise once the run has returned.
     if (state) {
-        VALUE exception = rb_errinfo();
+        wrapper->rb_host_error = rb_errinfo();
         rb_set_errinfo(Qnil);  // Clear the error
-        reraise_http_error_with_console(wrapper, exception);
-        // This line is never reached, but we need to return something
-        return JS_EXCEPTION;
+        JS_ThrowInternalError(ctx, "fetch() failed");
+        return JS_SetUncatchableException(ctx);
     }
 
     // Extract response fields from Ruby hash
@@ -372,23 +748,105 @@ static JSValue js_response_json(JSContext *ctx, JSValue *this_val, int argc, JSV
     return body;
 }
 
+// Opcode counters handed to JS_SetOpcodeStats()
+struct JSOpcodeStatsBuf {
+    JSOpcodeStats stats;
+    int op_count;
+};
+
+static void opcode_stats_free(struct JSOpcodeStatsBuf *buf) {
+    if (buf) {
+        free(buf->stats.op_count);
+        free(buf->stats.op_pair_count);
+        free(buf);
+    }
+}
+
+static PreludeImage *prelude_image_retain(PreludeImage *prelude) {
+    __atomic_add_fetch(&prelude->refcount, 1, __ATOMIC_RELAXED);
+    return prelude;
+}
+
+// Sandboxes in other Ractors may drop their references concurrently
+static void prelude_image_release(PreludeImage *prelude) {
+    if (__atomic_sub_fetch(&prelude->refcount, 1, __ATOMIC_ACQ_REL) == 0) {
+        if (prelude->image) {
+            munmap(prelude->image, prelude->image_size);
+        }
+        free(prelude);
+    }
+}
+
+static void prelude_free(void *ptr) {
+    if (ptr) {
+        prelude_image_release((PreludeImage *)ptr);
+    }
+}
+
+static size_t prelude_memsize(const void *ptr) {
+    const PreludeImage *prelude = (const PreludeImage *)ptr;
+    return sizeof(PreludeImage) + (prelude ? prelude->image_size : 0);
+}
+
+// Frozen once compiled, so a prelude can be shared with other Ractors
+static const rb_data_type_t prelude_type = {
+    "MQuickJS::NativePrelude",
+    {NULL, prelude_free, prelude_memsize,},
+    NULL, NULL,
+    RUBY_TYPED_FREE_IMMEDIATELY | RUBY_TYPED_FROZEN_SHAREABLE,
+};
+
+static VALUE prelude_alloc(VALUE klass) {
+    PreludeImage *prelude = calloc(1, sizeof(PreludeImage));
+    if (!prelude) {
+        rb_raise(rb_eNoMemError, "Failed to allocate prelude");
+    }
+    prelude->refcount = 1;
+    return TypedData_Wrap_Struct(klass, &prelude_type, prelude);
+}
+
 // Ruby C API helper functions
+// Free the JavaScript context and its arena; the wrapper stays valid
+static void sandbox_release(ContextWrapper *wrapper) {
+    if (wrapper->ctx) {
+        JS_FreeContext(wrapper->ctx);
+        wrapper->ctx = NULL;
+    }
+    // Only after the context, whose functions point into the image
+    if (wrapper->prelude) {
+        prelude_image_release(wrapper->prelude);
+        wrapper->prelude = NULL;
+    }
+    if (wrapper->mem_buf) {
+        free(wrapper->mem_buf);
+        wrapper->mem_buf = NULL;
+    }
+    if (wrapper->console_output) {
+        free(wrapper->console_output);
+        wrapper->console_output = NULL;
+    }
+    opcode_stats_free(wrapper->opcode_stats);
+    wrapper->opcode_stats = NULL;
+}
+
 static void sandbox_free(void *ptr) {
     ContextWrapper *wrapper = (ContextWrapper *)ptr;
     if (wrapper) {
-        if (wrapper->ctx) {
-            JS_FreeContext(wrapper->ctx);
-        }
-        if (wrapper->mem_buf) {
-            free(wrapper->mem_buf);
-        }
-        if (wrapper->console_output) {
-            free(wrapper->console_output);
-        }
+        sandbox_release(wrapper);
         free(wrapper);
     }
 }
 
+static void sandbox_mark(void *ptr) {
+    ContextWrapper *wrapper = (ContextWrapper *)ptr;
+    if (wrapper) {
+        rb_gc_mark(wrapper->rb_http_callback);
+        rb_gc_mark(wrapper->rb_profile_samples);
+        rb_gc_mark(wrapper->rb_alloc_samples);
+        rb_gc_mark(wrapper->rb_host_error);
+    }
+}
+
 static size_t sandbox_memsize(const void *ptr) {
     const ContextWrapper *wrapper = (const ContextWrapper *)ptr;
     return sizeof(ContextWrapper) + (wrapper ? wrapper->mem_size : 0);
@@ -396,7 +854,7 @@ static size_t sandbox_memsize(const void *ptr) {
 
 static const rb_data_type_t sandbox_type = {
     "MQuickJS::NativeSandbox",
-    {NULL, sandbox_free, sandbox_memsize,},
+    {sandbox_mark, sandbox_free, sandbox_memsize,},
     NULL, NULL,
     RUBY_TYPED_FREE_IMMEDIATELY,
 };
@@ -405,11 +863,81 @@ static const rb_data_type_t sandbox_type = {
 static VALUE sandbox_alloc(VALUE klass) {
     ContextWrapper *wrapper = malloc(sizeof(ContextWrapper));
     memset(wrapper, 0, sizeof(ContextWrapper));
+    wrapper->rb_http_callback = Qnil;
+    wrapper->rb_profile_samples = Qnil;
+    wrapper->rb_alloc_samples = Qnil;
+    wrapper->rb_host_error = Qnil;
     return TypedData_Wrap_Struct(klass, &sandbox_type, wrapper);
 }
 
+// Nesting limit of value conversions, which also stops them on cyclic
+// values
+#define CONVERT_MAX_DEPTH 1000
+
+// Object keys converted so far, keyed by the key's atom: the records of
+// tabular results share their keys, which are then converted once per
+// result instead of once per record. Entries are dropped whenever the
+// conversion allocates in the JS heap, since a GC moves the atoms.
+#define JS_TO_RUBY_KEY_CACHE_SIZE 64
+
+// State of one js_to_ruby conversion. The containers being converted
+// are rooted in refs, so a getter or a toString() called on the way can
+// run the GC without invalidating them.
+typedef struct {
+    JSContext *ctx;
+    int symbolize_keys;
+    int depth;
+    int too_deep;
+    JSValue root;
+    JSValue key_atoms[JS_TO_RUBY_KEY_CACHE_SIZE];
+    VALUE rb_keys[JS_TO_RUBY_KEY_CACHE_SIZE];
+    JSGCRef refs[CONVERT_MAX_DEPTH];
+} JSToRubyState;
+
+static void js_to_ruby_forget_keys(JSToRubyState *state) {
+    memset(state->rb_keys, 0, sizeof(state->rb_keys));
+}
+
+// Ruby key for an object key (a short integer or an atom): a frozen,
+// deduplicated String, or a Symbol with symbolize_keys
+static VALUE js_key_to_ruby(JSToRubyState *state, JSValue key) {
+    uint32_t h = (uint32_t)((key >> 2) * 0x9E3779B1u) >> 26;
+    if (state->rb_keys[h] && state->key_atoms[h] == key) {
+        return state->rb_keys[h];
+    }
+
+    char num_buf[16];
+    JSCStringBuf buf;
+    const char *str;
+    size_t len;
+    if (JS_IsInt(key)) {
+        len = snprintf(num_buf, sizeof(num_buf), "%d", JS_VALUE_GET_INT(key));
+        str = num_buf;
+    } else {
+        // Atoms are strings, so this does not allocate
+        str = JS_ToCStringLen(state->ctx, &len, key, &buf);
+    }
+
+#ifdef HAVE_RB_ENC_INTERNED_STR
+    VALUE rb_key = rb_enc_interned_str(str, len, rb_utf8_encoding());
+#else
+    VALUE rb_key = rb_funcall(rb_enc_str_new(str, len, rb_utf8_encoding()), rb_intern("-@"), 0);
+#endif
+    // Sandboxed code picks the keys: intern them as dynamic Symbols,
+    // which are garbage collected, rather than with rb_intern
+    if (state->symbolize_keys) {
+        rb_key = rb_str_intern(rb_key);
+    }
+
+    state->key_atoms[h] = key;
+    state->rb_keys[h] = rb_key;
+    return rb_key;
+}
+
 // Convert JavaScript value to Ruby value
-static VALUE js_to_ruby(JSContext *ctx, JSValue val) {
+static VALUE js_to_ruby(JSToRubyState *state, JSValue val) {
+    JSContext *ctx = state->ctx;
+
     // Null
     if (val == JS_NULL) {
         return Qnil;
@@ -454,55 +982,60 @@ static VALUE js_to_ruby(JSContext *ctx, JSValue val) {
         if (str) {
             VALUE rb_str = rb_str_new2(str);
             rb_enc_associate(rb_str, rb_utf8_encoding());
+            metrics_add(METRIC_BYTES_CONVERTED, RSTRING_LEN(rb_str));
             return rb_str;
         }
     }
 
-    // Array
     int class_id = JS_GetClassID(ctx, val);
-    if (class_id == JS_CLASS_ARRAY) {
-        VALUE rb_array = rb_ary_new();
-        JSValue len_val = JS_GetPropertyStr(ctx, val, "length");
-        uint32_t len = 0;
-        JS_ToUint32(ctx, &len, len_val);
-
-        for (uint32_t i = 0; i < len; i++) {
-            JSValue elem = JS_GetPropertyUint32(ctx, val, i);
-            VALUE rb_elem = js_to_ruby(ctx, elem);
-            rb_ary_push(rb_array, rb_elem);
-        }
-        return rb_array;
-    }
-
-    // Object
-    if (class_id == JS_CLASS_OBJECT) {
-        VALUE rb_hash = rb_hash_new();
-        JSValue keys = js_object_keys(ctx, NULL, 1, &val);
-
-        if (!JS_IsException(keys)) {
-            JSValue keys_len_val = JS_GetPropertyStr(ctx, keys, "length");
-            uint32_t keys_len = 0;
-            JS_ToUint32(ctx, &keys_len, keys_len_val);
-
-            for (uint32_t i = 0; i < keys_len; i++) {
-                JSValue key_val = JS_GetPropertyUint32(ctx, keys, i);
-                JSCStringBuf key_buf;
-                const char *key = JS_ToCString(ctx, key_val, &key_buf);
-
-                if (key) {
-                    JSValue prop_val = JS_GetPropertyStr(ctx, val, key);
-                    VALUE rb_val = js_to_ruby(ctx, prop_val);
-                    VALUE rb_key = rb_str_new2(key);
-                    rb_enc_associate(rb_key, rb_utf8_encoding());
-                    rb_hash_aset(rb_hash, rb_key, rb_val);
+    if (class_id == JS_CLASS_ARRAY || class_id == JS_CLASS_OBJECT) {
+        if (state->depth == CONVERT_MAX_DEPTH) {
+            state->too_deep = 1;
+            return Qnil;
+        }
+        JSGCRef *ref = &state->refs[state->depth++];
+        JS_PushGCRef(ctx, ref)[0] = val;
+        VALUE rb_val;
+
+        // Array
+        if (class_id == JS_CLASS_ARRAY) {
+            int len = JS_GetArrayLength(ctx, val);
+            rb_val = rb_ary_new_capa(len);
+
+            for (int i = 0; i < len && !state->too_deep; i++) {
+                JSValue elem = JS_GetPropertyUint32(ctx, ref->val, i);
+                rb_ary_push(rb_val, js_to_ruby(state, elem));
+            }
+        } else {
+            // Object: own properties, read in place
+            rb_val = rb_hash_new();
+            uint32_t pos = 0;
+            JSValue key, prop_val;
+
+            while (!state->too_deep && JS_GetOwnPropertyAt(ctx, ref->val, &pos, &key, &prop_val)) {
+                VALUE rb_key = js_key_to_ruby(state, key);
+                if (prop_val == JS_UNINITIALIZED) {
+                    // A getter runs JavaScript
+                    VALUE rb_name = SYMBOL_P(rb_key) ? rb_sym2str(rb_key) : rb_key;
+                    prop_val = JS_GetPropertyStr(ctx, ref->val, RSTRING_PTR(rb_name));
+                    js_to_ruby_forget_keys(state);
+                    if (JS_IsException(prop_val)) {
+                        JS_GetException(ctx);
+                        prop_val = JS_UNDEFINED;
+                    }
                 }
+                rb_hash_aset(rb_val, rb_key, js_to_ruby(state, prop_val));
             }
         }
-        return rb_hash;
+
+        JS_PopGCRef(ctx, ref);
+        state->depth--;
+        return rb_val;
     }
 
     // Fallback: convert to string
     JSValue str_val = JS_ToString(ctx, val);
+    js_to_ruby_forget_keys(state);
     if (!JS_IsException(str_val)) {
         JSCStringBuf buf;
         const char *str = JS_ToCString(ctx, str_val, &buf);
@@ -516,13 +1049,60 @@ static VALUE js_to_ruby(JSContext *ctx, JSValue val) {
     return Qnil;
 }
 
+static VALUE js_to_ruby_body(VALUE arg) {
+    JSToRubyState *state = (JSToRubyState *)arg;
+    return js_to_ruby(state, state->root);
+}
+
+// Convert an eval result to Ruby. A Ruby exception raised on the way is
+// re-raised once the GC refs of the conversion are unlinked from the
+// context.
+static VALUE js_result_to_ruby(ContextWrapper *wrapper, JSValue val) {
+    JSToRubyState state;
+    state.ctx = wrapper->ctx;
+    state.symbolize_keys = wrapper->symbolize_keys;
+    state.depth = 0;
+    state.too_deep = 0;
+    state.root = val;
+    js_to_ruby_forget_keys(&state);
+
+    int error = 0;
+    VALUE rb_value = rb_protect(js_to_ruby_body, (VALUE)&state, &error);
+    if (error) {
+        if (state.depth > 0) {
+            JS_PopGCRef(wrapper->ctx, &state.refs[0]);
+        }
+        rb_jump_tag(error);
+    }
+    if (state.too_deep) {
+        VALUE argv[4] = {
+            rb_str_new_cstr("RangeError: value too deeply nested to convert"),
+            Qnil,
+            rb_str_new(wrapper->console_output, wrapper->console_output_len),
+            wrapper->console_truncated ? Qtrue : Qfalse
+        };
+        rb_exc_raise(rb_class_new_instance(4, argv, rb_eMQuickJSJavascriptError));
+    }
+    return rb_value;
+}
+
+// State of one ruby_to_js conversion, rooting the arrays and objects
+// being filled while their elements are converted
+typedef struct {
+    JSContext *ctx;
+    int depth;
+    VALUE rb_root;
+    JSValue result;
+    JSGCRef refs[CONVERT_MAX_DEPTH];
+} RubyToJSState;
+
 // Forward declaration
-static JSValue ruby_to_js(JSContext *ctx, VALUE rb_val);
+static JSValue ruby_to_js(RubyToJSState *state, VALUE rb_val);
 
 // Helper struct for hash iteration
 struct hash_iter_data {
-    JSContext *ctx;
-    JSValue obj;
+    RubyToJSState *state;
+    JSGCRef *obj_ref;
     int has_error;
 };
 
@@ -549,7 +1129,7 @@ static int hash_foreach_cb(VALUE key, VALUE val, VALUE arg) {
     }
 
     // Convert value
-    JSValue js_val = ruby_to_js(data->ctx, val);
+    JSValue js_val = ruby_to_js(data->state, val);
 
     if (JS_IsException(js_val)) {
         data->has_error = 1;
@@ -557,13 +1137,18 @@ static int hash_foreach_cb(VALUE key, VALUE val, VALUE arg) {
     }
 
     // Set property
-    JS_SetPropertyStr(data->ctx, data->obj, key_str, js_val);
+    if (JS_IsException(JS_SetPropertyStr(data->state->ctx, data->obj_ref->val, key_str, js_val))) {
+        data->has_error = 1;
+        return ST_STOP;
+    }
 
     return ST_CONTINUE;
 }
 
 // Convert Ruby value to JavaScript value
-static JSValue ruby_to_js(JSContext *ctx, VALUE rb_val) {
+static JSValue ruby_to_js(RubyToJSState *state, VALUE rb_val) {
+    JSContext *ctx = state->ctx;
+
     // nil -> null
     if (NIL_P(rb_val)) {
         return JS_NULL;
@@ -600,6 +1185,7 @@ static JSValue ruby_to_js(JSContext *ctx, VALUE rb_val) {
     // String -> string
     if (type == T_STRING) {
         const char *str = StringValueCStr(rb_val);
+        metrics_add(METRIC_BYTES_CONVERTED, RSTRING_LEN(rb_val));
         return JS_NewString(ctx, str);
     }
 
@@ -609,6 +1195,12 @@ static JSValue ruby_to_js(JSContext *ctx, VALUE rb_val) {
         return JS_NewString(ctx, str);
     }
 
+    if (type == T_ARRAY || type == T_HASH) {
+        if (state->depth == CONVERT_MAX_DEPTH) {
+            rb_raise(rb_eArgError, "Value too deeply nested to convert");
+        }
+    }
+
     // Array -> array
     if (type == T_ARRAY) {
         long len = RARRAY_LEN(rb_val);
@@ -618,17 +1210,25 @@ static JSValue ruby_to_js(JSContext *ctx, VALUE rb_val) {
             return js_array;
         }
 
+        JSGCRef *ref = &state->refs[state->depth++];
+        JS_PushGCRef(ctx, ref)[0] = js_array;
+
         for (long i = 0; i < len; i++) {
             VALUE rb_element = rb_ary_entry(rb_val, i);
-            JSValue js_element = ruby_to_js(ctx, rb_element);
+            JSValue js_element = ruby_to_js(state, rb_element);
 
-            if (JS_IsException(js_element)) {
-                return js_element;
+            if (JS_IsException(js_element) ||
+                JS_IsException(JS_SetPropertyUint32(ctx, ref->val, (uint32_t)i, js_element))) {
+                js_array = JS_EXCEPTION;
+                break;
             }
-
-            JS_SetPropertyUint32(ctx, js_array, (uint32_t)i, js_element);
         }
 
+        if (!JS_IsException(js_array)) {
+            js_array = ref->val;
+        }
+        JS_PopGCRef(ctx, ref);
+        state->depth--;
         return js_array;
     }
 
@@ -640,15 +1240,21 @@ static JSValue ruby_to_js(JSContext *ctx, VALUE rb_val) {
             return js_obj;
         }
 
+        JSGCRef *ref = &state->refs[state->depth++];
+        JS_PushGCRef(ctx, ref)[0] = js_obj;
+
         struct hash_iter_data iter_data = {
-            .ctx = ctx,
-            .obj = js_obj,
+            .state = state,
+            .obj_ref = ref,
             .has_error = 0
         };
 
         // Iterate over hash
         rb_hash_foreach(rb_val, hash_foreach_cb, (VALUE)&iter_data);
 
+        js_obj = JS_PopGCRef(ctx, ref);
+        state->depth--;
+
         if (iter_data.has_error) {
             return JS_EXCEPTION;
         }
@@ -661,6 +1267,32 @@ static JSValue ruby_to_js(JSContext *ctx, VALUE rb_val) {
     return JS_NewString(ctx, StringValueCStr(rb_str));
 }
 
+static VALUE ruby_to_js_body(VALUE arg) {
+    RubyToJSState *state = (RubyToJSState *)arg;
+    state->result = ruby_to_js(state, state->rb_root);
+    return Qnil;
+}
+
+// Convert a Ruby value for the sandbox. A Ruby exception raised on the
+// way (e.g. by a to_s) is re-raised once the GC refs of the conversion
+// are unlinked from the context.
+static JSValue ruby_value_to_js(ContextWrapper *wrapper, VALUE rb_val) {
+    RubyToJSState state;
+    state.ctx = wrapper->ctx;
+    state.depth = 0;
+    state.rb_root = rb_val;
+
+    int error = 0;
+    rb_protect(ruby_to_js_body, (VALUE)&state, &error);
+    if (error) {
+        if (state.depth > 0) {
+            JS_PopGCRef(wrapper->ctx, &state.refs[0]);
+        }
+        rb_jump_tag(error);
+    }
+    return state.result;
+}
+
 // Sandbox#initialize
 static VALUE sandbox_initialize(int argc, VALUE *argv, VALUE self) {
     ContextWrapper *wrapper;
@@ -673,6 +1305,9 @@ static VALUE sandbox_initialize(int argc, VALUE *argv, VALUE self) {
     size_t memory_limit = 50000;
     int64_t timeout_ms = 5000;
     size_t console_max_size = 10000;
+    int collect_timings = 0;
+    int stdlib_profile = 0;
+    int symbolize_keys = 0;
 
     // Parse options
     if (!NIL_P(opts)) {
@@ -686,18 +1321,30 @@ static VALUE sandbox_initialize(int argc, VALUE *argv, VALUE self) {
 
         val = rb_hash_aref(opts, ID2SYM(rb_intern("console_log_max_size")));
         if (!NIL_P(val)) console_max_size = NUM2SIZET(val);
+
+        collect_timings = RTEST(rb_hash_aref(opts, ID2SYM(rb_intern("timings"))));
+
+        val = rb_hash_aref(opts, ID2SYM(rb_intern("stdlib")));
+        if (!NIL_P(val)) stdlib_profile = stdlib_profile_index(val);
+
+        symbolize_keys = RTEST(rb_hash_aref(opts, ID2SYM(rb_intern("symbolize_keys"))));
     }
 
     // Allocate memory buffer
+    int64_t alloc_start_ns = get_time_ns();
     wrapper->mem_buf = malloc(memory_limit);
     if (!wrapper->mem_buf) {
         rb_raise(rb_eNoMemError, "Failed to allocate memory buffer");
     }
+    wrapper->arena_alloc_ns = get_time_ns() - alloc_start_ns;
 
     wrapper->mem_size = memory_limit;
     wrapper->timeout_ms = timeout_ms;
     wrapper->timed_out = 0;
     wrapper->start_time_ms = 0;
+    wrapper->collect_timings = collect_timings;
+    wrapper->stdlib_profile = stdlib_profile;
+    wrapper->symbolize_keys = symbolize_keys;
 
     // Initialize console output buffer
     wrapper->console_max_size = console_max_size;
@@ -717,16 +1364,19 @@ static VALUE sandbox_initialize(int argc, VALUE *argv, VALUE self) {
     wrapper->rb_http_callback = Qnil;
 
     // Create JS context
-    wrapper->ctx = JS_NewContext(wrapper->mem_buf, memory_limit, &js_stdlib);
+    int64_t context_start_ns = get_time_ns();
+    wrapper->ctx = JS_NewContext(wrapper->mem_buf, memory_limit, js_stdlib_profiles[stdlib_profile].def);
     if (!wrapper->ctx) {
         free(wrapper->console_output);
         free(wrapper->mem_buf);
         rb_raise(rb_eRuntimeError, "Failed to create JavaScript context");
     }
+    wrapper->new_context_ns = get_time_ns() - context_start_ns;
 
     // Set interrupt handler
     JS_SetContextOpaque(wrapper->ctx, wrapper);
     JS_SetInterruptHandler(wrapper->ctx, interrupt_handler);
+    JS_SetGCHook(wrapper->ctx, gc_hook);
 
     return self;
 }
@@ -746,90 +1396,341 @@ static VALUE sandbox_set_http_callback(VALUE self, VALUE callback) {
     return callback;
 }
 
-// Sandbox#eval
-static VALUE sandbox_eval(VALUE self, VALUE code_str) {
+// Build the Result#timings hash, durations in milliseconds
+static VALUE timings_to_ruby(const EvalTimings *timings) {
+    VALUE hash = rb_hash_new();
+    rb_hash_aset(hash, ID2SYM(rb_intern("parse_ms")), DBL2NUM(timings->parse_ns / 1e6));
+    rb_hash_aset(hash, ID2SYM(rb_intern("run_ms")), DBL2NUM(timings->run_ns / 1e6));
+    rb_hash_aset(hash, ID2SYM(rb_intern("convert_ms")), DBL2NUM(timings->convert_ns / 1e6));
+    rb_hash_aset(hash, ID2SYM(rb_intern("gc_ms")), DBL2NUM(timings->gc_ns / 1e6));
+    rb_hash_aset(hash, ID2SYM(rb_intern("gc_count")), INT2NUM(timings->gc_count));
+    rb_hash_aset(hash, ID2SYM(rb_intern("gc_max_ms")), DBL2NUM(timings->gc_max_ns / 1e6));
+    rb_hash_aset(hash, ID2SYM(rb_intern("host_ms")), DBL2NUM(timings->host_ns / 1e6));
+    rb_hash_aset(hash, ID2SYM(rb_intern("host_calls")), INT2NUM(timings->host_calls));
+    rb_hash_aset(hash, ID2SYM(rb_intern("total_ms")),
+                 DBL2NUM((timings->parse_ns + timings->run_ns + timings->convert_ns) / 1e6));
+    return hash;
+}
+
+// The "stack" property of a thrown error object, or nil if it has none
+static VALUE js_error_stack(JSContext *ctx, JSValue exc) {
+    JSValue stack_val = JS_GetPropertyStr(ctx, exc, "stack");
+    if (JS_IsUndefined(stack_val) || JS_IsNull(stack_val) || JS_IsException(stack_val)) {
+        return Qnil;
+    }
+
+    JSCStringBuf stack_buf;
+    const char *stack_str = JS_ToCString(ctx, stack_val, &stack_buf);
+    return stack_str ? rb_str_new_cstr(stack_str) : Qnil;
+}
+
+// Deadline of one time slice, or 0 to run until the script finishes
+static int64_t slice_deadline(VALUE slice_ms) {
+    if (NIL_P(slice_ms)) {
+        return 0;
+    }
+
+    int64_t ms = NUM2LL(slice_ms);
+    if (ms <= 0) {
+        rb_raise(rb_eArgError, "slice_ms must be positive");
+    }
+    return get_time_ns() + ms * 1000000;
+}
+
+static VALUE sandbox_finish_run(ContextWrapper *wrapper, JSValue result);
+
+// A host callback such as fetch() runs Ruby code while the interpreter
+// is in the middle of a run. If that code blocks under Fiber.scheduler,
+// other fibers run meanwhile, and they or the callback itself must not
+// re-enter or free this sandbox.
+static void check_not_running(ContextWrapper *wrapper) {
+    if (wrapper->running) {
+        rb_raise(rb_eRuntimeError, "Sandbox is already running JavaScript");
+    }
+}
+
+enum { RUN_START, RUN_RESUME, RUN_ABORT };
+
+struct js_run_args {
     ContextWrapper *wrapper;
-    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+    JSValue value;
+    int mode;
+};
+
+static VALUE js_run_body(VALUE arg) {
+    struct js_run_args *args = (struct js_run_args *)arg;
+    JSContext *ctx = args->wrapper->ctx;
+
+    args->wrapper->running = 1;
+    if (args->mode == RUN_START) {
+        args->value = JS_Run(ctx, args->value);
+    } else {
+        args->value = JS_Resume(ctx, args->mode == RUN_ABORT);
+    }
+    return Qnil;
+}
+
+static VALUE js_run_done(VALUE arg) {
+    ((struct js_run_args *)arg)->wrapper->running = 0;
+    return Qnil;
+}
+
+// Run parsed code, or continue or abort a suspended run. The running
+// flag is cleared in an ensure in case Ruby code called from a host
+// function raises through the interpreter.
+static JSValue sandbox_run_js(ContextWrapper *wrapper, JSValue code, int mode) {
+    struct js_run_args args = { wrapper, code, mode };
+    rb_ensure(js_run_body, (VALUE)&args, js_run_done, (VALUE)&args);
+    return args.value;
+}
 
+// Check that a sandbox can start an eval
+static void check_can_eval(ContextWrapper *wrapper) {
     if (!wrapper || !wrapper->ctx) {
         rb_raise(rb_eRuntimeError, "Invalid sandbox state");
     }
+    check_not_running(wrapper);
+    if (JS_IsSuspended(wrapper->ctx)) {
+        rb_raise(rb_eRuntimeError, "Sandbox has a suspended eval, resume or cancel it first");
+    }
+}
+
+// Parse and run code, returning its value or JS_EXCEPTION, for
+// sandbox_finish_run
+static JSValue sandbox_eval_js(ContextWrapper *wrapper, VALUE code_str, VALUE slice_ms) {
+    wrapper->slice_deadline_ns = slice_deadline(slice_ms);
 
     // Reset console output
     wrapper->console_output[0] = '\0';
     wrapper->console_output_len = 0;
     wrapper->console_truncated = 0;
+    wrapper->impure = 0;
 
     // Get code string
     const char *code = StringValueCStr(code_str);
     size_t code_len = RSTRING_LEN(code_str);
 
     // Set timing
+    wrapper->eval_start_ns = get_time_ns();
     wrapper->start_time_ms = get_time_ms();
     wrapper->timed_out = 0;
+    if (wrapper->profiling) {
+        wrapper->profile_next_sample_ns = get_time_ns() + wrapper->profile_interval_ns;
+    }
 
-    // Set current wrapper for console.log
-    current_wrapper = wrapper;
-
-    // Evaluate JavaScript
-    JSValue result = JS_Eval(wrapper->ctx, code, code_len, "<eval>", 1);
+    if (wrapper->collect_timings) {
+        memset(&wrapper->timings, 0, sizeof(wrapper->timings));
+    }
 
-    // Clear current wrapper
-    current_wrapper = NULL;
+    // Writes to the objects that exist now make the eval impure
+    JS_StartWriteTracking(wrapper->ctx);
+
+    // Evaluate JavaScript (JS_Eval split in two so each phase can be timed)
+    int64_t parse_start_ns = wrapper->collect_timings ? get_time_ns() : 0;
+    JSValue result = JS_Parse(wrapper->ctx, code, code_len, "<eval>", JS_EVAL_RETVAL);
+    if (wrapper->collect_timings) {
+        int64_t run_start_ns = get_time_ns();
+        wrapper->timings.parse_ns = run_start_ns - parse_start_ns;
+        if (!JS_IsException(result)) {
+            result = sandbox_run_js(wrapper, result, RUN_START);
+            wrapper->timings.run_ns = get_time_ns() - run_start_ns;
+        }
+    } else if (!JS_IsException(result)) {
+        result = sandbox_run_js(wrapper, result, RUN_START);
+    }
 
-    // Check for timeout
-    if (wrapper->timed_out) {
-        // Create console output strings before raising
-        VALUE console_output = rb_str_new(wrapper->console_output, wrapper->console_output_len);
-        VALUE console_truncated = wrapper->console_truncated ? Qtrue : Qfalse;
+    return result;
+}
 
-        // Create timeout error with console output
-        VALUE timeout_argv[3] = {
-            rb_str_new_cstr("JavaScript execution timeout exceeded"),
-            console_output,
-            console_truncated
-        };
-        VALUE timeout_exception = rb_class_new_instance(3, timeout_argv, rb_eMQuickJSTimeoutError);
-        rb_exc_raise(timeout_exception);
-    }
+// Sandbox#eval
+static VALUE sandbox_eval(VALUE self, VALUE code_str, VALUE slice_ms) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
 
-    // Check for exception
-    if (JS_IsException(result)) {
-        JSValue exc = JS_GetException(wrapper->ctx);
-        JSCStringBuf buf;
-        const char *msg = JS_ToCString(wrapper->ctx, exc, &buf);
+    check_can_eval(wrapper);
+    return sandbox_finish_run(wrapper, sandbox_eval_js(wrapper, code_str, slice_ms));
+}
+
+// Sandbox#resume
+static VALUE sandbox_resume(VALUE self, VALUE slice_ms) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    if (!wrapper || !wrapper->ctx) {
+        rb_raise(rb_eRuntimeError, "Invalid sandbox state");
+    }
+    check_not_running(wrapper);
+    if (!JS_IsSuspended(wrapper->ctx)) {
+        rb_raise(rb_eRuntimeError, "Sandbox has no suspended eval");
+    }
+    wrapper->slice_deadline_ns = slice_deadline(slice_ms);
+
+    // The timeout and the eval duration metric only count running time,
+    // so move their start past the time spent suspended
+    int64_t now_ns = get_time_ns();
+    int64_t suspended_ns = now_ns - wrapper->suspended_at_ns;
+    wrapper->eval_start_ns += suspended_ns;
+    wrapper->start_time_ms += suspended_ns / 1000000;
+    if (wrapper->profiling) {
+        wrapper->profile_next_sample_ns = now_ns + wrapper->profile_interval_ns;
+    }
+
+    JSValue result = sandbox_run_js(wrapper, JS_UNDEFINED, RUN_RESUME);
+    if (wrapper->collect_timings) {
+        wrapper->timings.run_ns += get_time_ns() - now_ns;
+    }
+
+    return sandbox_finish_run(wrapper, result);
+}
+
+// Sandbox#cancel
+static VALUE sandbox_cancel(VALUE self) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    if (!wrapper || !wrapper->ctx) {
+        rb_raise(rb_eRuntimeError, "Invalid sandbox state");
+    }
+    check_not_running(wrapper);
+    if (!JS_IsSuspended(wrapper->ctx)) {
+        return Qfalse;
+    }
+
+    // Unwind the suspended frames with the uncatchable "interrupted"
+    // error, which is dropped: the script never ran to an end
+    sandbox_run_js(wrapper, JS_UNDEFINED, RUN_ABORT);
+    JS_GetException(wrapper->ctx);
+    return Qtrue;
+}
+
+// Sandbox#suspended?
+static VALUE sandbox_suspended_p(VALUE self) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    return wrapper->ctx && JS_IsSuspended(wrapper->ctx) ? Qtrue : Qfalse;
+}
+
+// Whether the last eval (including its resumes) called Date.now,
+// performance.now, Math.random or fetch
+static VALUE sandbox_impure_p(VALUE self) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    return wrapper->impure ? Qtrue : Qfalse;
+}
+
+// Sandbox#write_count: a counter that changes whenever a global variable
+// is defined, assigned or deleted, by a script or from Ruby, or an eval
+// modifies an object that existed before it started
+static VALUE sandbox_write_count(VALUE self) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    if (!wrapper->ctx) {
+        return INT2FIX(0);
+    }
+    return UINT2NUM(JS_GetWriteCount(wrapper->ctx));
+}
+
+// Raise the error of a finished run, if it failed
+static void sandbox_check_run(ContextWrapper *wrapper, JSValue result) {
+    if (!NIL_P(wrapper->rb_host_error)) {
+        VALUE exception = wrapper->rb_host_error;
+        wrapper->rb_host_error = Qnil;
+        JS_GetException(wrapper->ctx);
+        reraise_http_error_with_console(wrapper, exception);
+    }
+
+    // Check for timeout
+    if (wrapper->timed_out) {
+        // Create console output strings before raising
+        VALUE console_output = rb_str_new(wrapper->console_output, wrapper->console_output_len);
+        VALUE console_truncated = wrapper->console_truncated ? Qtrue : Qfalse;
+
+        // The uncatchable "interrupted" error captured the backtrace of
+        // whatever was running when the deadline passed
+        JSValue exc = JS_GetException(wrapper->ctx);
+        VALUE rb_stack = js_error_stack(wrapper->ctx, exc);
+
+        // Create timeout error with stack and console output
+        VALUE timeout_argv[4] = {
+            rb_str_new_cstr("JavaScript execution timeout exceeded"),
+            console_output,
+            console_truncated,
+            rb_stack
+        };
+        VALUE timeout_exception = rb_class_new_instance(4, timeout_argv, rb_eMQuickJSTimeoutError);
+        metrics_record_eval(wrapper, METRIC_TIMEOUTS);
+        rb_exc_raise(timeout_exception);
+    }
+
+    // Check for exception
+    if (JS_IsException(result)) {
+        JSValue exc = JS_GetException(wrapper->ctx);
+        JSCStringBuf buf;
+        const char *msg = JS_ToCString(wrapper->ctx, exc, &buf);
 
         // Determine error class
         int class_id = JS_GetClassID(wrapper->ctx, exc);
         int is_syntax_error = (class_id == 13 || (msg && strncmp(msg, "SyntaxError", 11) == 0));
 
-        // Extract the stack trace for both SyntaxError and JavascriptError
+        int is_out_of_memory = !is_syntax_error && msg && strcmp(msg, "InternalError: out of memory") == 0;
+
+        // Extract the stack trace for every error class
         VALUE rb_message = rb_str_new_cstr(msg ? msg : "JavaScript error");
-        VALUE rb_stack = Qnil;
-
-        // Try to get the stack property from the error object
-        JSValue stack_val = JS_GetPropertyStr(wrapper->ctx, exc, "stack");
-        if (!JS_IsUndefined(stack_val) && !JS_IsNull(stack_val)) {
-            JSCStringBuf stack_buf;
-            const char *stack_str = JS_ToCString(wrapper->ctx, stack_val, &stack_buf);
-            if (stack_str) {
-                rb_stack = rb_str_new_cstr(stack_str);
-            }
-        }
+        VALUE rb_stack = js_error_stack(wrapper->ctx, exc);
 
         // Create console output strings
         VALUE console_output = rb_str_new(wrapper->console_output, wrapper->console_output_len);
         VALUE console_truncated = wrapper->console_truncated ? Qtrue : Qfalse;
 
+        if (is_out_of_memory) {
+            VALUE oom_argv[4] = {
+                rb_str_new_cstr("Memory limit exceeded"),
+                console_output,
+                console_truncated,
+                rb_stack
+            };
+            VALUE oom_exception = rb_class_new_instance(4, oom_argv, rb_eMQuickJSMemoryLimitError);
+            metrics_record_eval(wrapper, METRIC_MEMORY_LIMIT_ERRORS);
+            rb_exc_raise(oom_exception);
+        }
+
         // Create the appropriate error with message, stack, and console output
         VALUE argv[4] = { rb_message, rb_stack, console_output, console_truncated };
         VALUE error_class = is_syntax_error ? rb_eMQuickJSSyntaxError : rb_eMQuickJSJavascriptError;
         VALUE exception = rb_class_new_instance(4, argv, error_class);
+        metrics_record_eval(wrapper, is_syntax_error ? METRIC_SYNTAX_ERRORS : METRIC_JAVASCRIPT_ERRORS);
         rb_exc_raise(exception);
     }
+}
+
+// Build the Result of a finished eval or resume, or raise its error.
+// A run that stopped at the end of its time slice gives a suspended
+// Result holding the console output so far.
+static VALUE sandbox_finish_run(ContextWrapper *wrapper, JSValue result) {
+    wrapper->slice_deadline_ns = 0;
+
+    // A failing host callback unwinds the run, so it is never suspended
+    if (NIL_P(wrapper->rb_host_error) && JS_IsSuspended(wrapper->ctx)) {
+        wrapper->suspended_at_ns = get_time_ns();
+        VALUE rb_timings = wrapper->collect_timings ? timings_to_ruby(&wrapper->timings) : Qnil;
+        return rb_funcall(rb_cResult, rb_intern("new"), 6,
+                          Qnil, rb_str_new(wrapper->console_output, wrapper->console_output_len),
+                          wrapper->console_truncated ? Qtrue : Qfalse, rb_ary_new(), rb_timings, Qtrue);
+    }
+
+    sandbox_check_run(wrapper, result);
 
     // Convert result to Ruby
-    VALUE rb_value = js_to_ruby(wrapper->ctx, result);
+    int64_t convert_start_ns = wrapper->collect_timings ? get_time_ns() : 0;
+    VALUE rb_value = js_result_to_ruby(wrapper, result);
+    VALUE rb_timings = Qnil;
+    if (wrapper->collect_timings) {
+        wrapper->timings.convert_ns = get_time_ns() - convert_start_ns;
+        rb_timings = timings_to_ruby(&wrapper->timings);
+    }
 
     // Create console output string
     VALUE console_output = rb_str_new(wrapper->console_output, wrapper->console_output_len);
@@ -837,8 +1738,10 @@ static VALUE sandbox_eval(VALUE self, VALUE code_str) {
 
     // Create Result object
     VALUE http_requests = rb_ary_new();  // Empty for now
-    VALUE result_obj = rb_funcall(rb_cResult, rb_intern("new"), 4,
-                                  rb_value, console_output, console_truncated, http_requests);
+    VALUE result_obj = rb_funcall(rb_cResult, rb_intern("new"), 5,
+                                  rb_value, console_output, console_truncated, http_requests,
+                                  rb_timings);
+    metrics_record_eval(wrapper, -1);
 
     return result_obj;
 }
@@ -852,6 +1755,8 @@ static VALUE sandbox_set_variable(VALUE self, VALUE name, VALUE value) {
         rb_raise(rb_eRuntimeError, "Invalid sandbox state");
     }
 
+    check_not_running(wrapper);
+
     // Get variable name
     const char *var_name = StringValueCStr(name);
 
@@ -861,7 +1766,7 @@ static VALUE sandbox_set_variable(VALUE self, VALUE name, VALUE value) {
     }
 
     // Convert Ruby value to JS value
-    JSValue js_val = ruby_to_js(wrapper->ctx, value);
+    JSValue js_val = ruby_value_to_js(wrapper, value);
 
     if (JS_IsException(js_val)) {
         rb_raise(rb_eRuntimeError, "Failed to convert Ruby value to JavaScript value");
@@ -876,8 +1781,884 @@ static VALUE sandbox_set_variable(VALUE self, VALUE name, VALUE value) {
     return value;
 }
 
+// Sandbox#transfer: evaluate code and copy its value straight into the
+// target sandbox's heap as a global, with JS_CloneValue
+static VALUE sandbox_transfer(VALUE self, VALUE code_str, VALUE rb_target, VALUE name) {
+    ContextWrapper *wrapper, *target;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+    TypedData_Get_Struct(rb_target, ContextWrapper, &sandbox_type, target);
+
+    check_can_eval(wrapper);
+    if (!target->ctx) {
+        rb_raise(rb_eRuntimeError, "Invalid sandbox state");
+    }
+    check_not_running(target);
+    if (target == wrapper) {
+        rb_raise(rb_eArgError, "Cannot transfer a value to the same sandbox");
+    }
+
+    const char *var_name = StringValueCStr(name);
+    if (var_name[0] == '\0') {
+        rb_raise(rb_eArgError, "Variable name cannot be empty");
+    }
+
+    JSValue value = sandbox_eval_js(wrapper, code_str, Qnil);
+    wrapper->slice_deadline_ns = 0;
+    sandbox_check_run(wrapper, value);
+    metrics_record_eval(wrapper, -1);
+
+    // The source context does not run until the copy is done, so value
+    // stays valid while the target allocates
+    JSValue copy = JS_CloneValue(target->ctx, wrapper->ctx, value);
+    if (!JS_IsException(copy)) {
+        copy = JS_SetPropertyStr(target->ctx, JS_GetGlobalObject(target->ctx), var_name, copy);
+    }
+    if (JS_IsException(copy)) {
+        JSValue exc = JS_GetException(target->ctx);
+        JSCStringBuf buf;
+        const char *msg = JS_ToCString(target->ctx, exc, &buf);
+        VALUE console_output = rb_str_new(wrapper->console_output, wrapper->console_output_len);
+        VALUE console_truncated = wrapper->console_truncated ? Qtrue : Qfalse;
+
+        if (msg && strcmp(msg, "InternalError: out of memory") == 0) {
+            VALUE oom_argv[4] = {
+                rb_str_new_cstr("Memory limit exceeded in the target sandbox"),
+                console_output,
+                console_truncated,
+                Qnil
+            };
+            rb_exc_raise(rb_class_new_instance(4, oom_argv, rb_eMQuickJSMemoryLimitError));
+        }
+        VALUE argv[4] = {
+            rb_str_new_cstr(msg ? msg : "JavaScript error"), Qnil, console_output, console_truncated
+        };
+        rb_exc_raise(rb_class_new_instance(4, argv, rb_eMQuickJSJavascriptError));
+    }
+
+    return Qnil;
+}
+
+// Sandbox#transform_stream: run a function over a chunk of JSON Lines.
+// Each line is parsed in JSON mode, passed to the function and its
+// result serialized with JSON.stringify, all inside the engine; only the
+// output text is copied to Ruby.
+struct transform_args {
+    ContextWrapper *wrapper;
+    JSGCRef func_ref;
+    JSGCRef stringify_ref;
+    char *lines;  // Private copy of the chunk, NUL-terminated
+    size_t len;
+    int stop_on_error;
+    VALUE rb_output;
+    VALUE rb_errors;  // [line index in the chunk, message]
+    long records;
+    long written;
+};
+
+// Call func(arg) with an undefined this
+static JSValue transform_call(JSContext *ctx, JSValue func, JSValue arg) {
+    JSGCRef func_ref, arg_ref;
+
+    JS_PUSH_VALUE(ctx, func);
+    JS_PUSH_VALUE(ctx, arg);
+    int err = JS_StackCheck(ctx, 3);
+    JS_POP_VALUE(ctx, arg);
+    JS_POP_VALUE(ctx, func);
+    if (err) {
+        return JS_EXCEPTION;
+    }
+    JS_PushArg(ctx, arg);
+    JS_PushArg(ctx, func);
+    JS_PushArg(ctx, JS_UNDEFINED);
+    return JS_Call(ctx, 1);
+}
+
+static VALUE transform_body(VALUE arg) {
+    struct transform_args *args = (struct transform_args *)arg;
+    ContextWrapper *wrapper = args->wrapper;
+    JSContext *ctx = wrapper->ctx;
+    char *line = args->lines;
+    char *end = args->lines + args->len;
+
+    wrapper->running = 1;
+    for (long index = 0; line < end; index++) {
+        // Records are delimited by '\n' only: a NUL byte inside one is
+        // part of it. The '\n' is overwritten to terminate it for the parser.
+        char *newline = memchr(line, '\n', end - line);
+        size_t line_len = newline ? (size_t)(newline - line) : (size_t)(end - line);
+        char *next = line + line_len + 1;
+        line[line_len] = '\0';
+        if (line_len > 0 && line[line_len - 1] == '\r') {
+            line[--line_len] = '\0';
+        }
+        if (line_len == 0) {
+            line = next;
+            continue;
+        }
+
+        // The timeout and the eval metrics apply to each record
+        wrapper->start_time_ms = get_time_ms();
+        wrapper->eval_start_ns = get_time_ns();
+        JSValue value = JS_Parse(ctx, line, line_len, "<input>", JS_EVAL_JSON);
+        if (!JS_IsException(value)) {
+            value = transform_call(ctx, args->func_ref.val, value);
+        }
+        if (!JS_IsException(value) && value != JS_UNDEFINED) {
+            value = transform_call(ctx, args->stringify_ref.val, value);
+        }
+        args->records++;
+
+        if (JS_IsException(value)) {
+            // sandbox_check_run records the error ending the stream
+            if (wrapper->timed_out || !NIL_P(wrapper->rb_host_error)) {
+                break;
+            }
+            JSValue exc = JS_GetException(ctx);
+            JSCStringBuf buf;
+            const char *msg = JS_ToCString(ctx, exc, &buf);
+            if (msg && strncmp(msg, "SyntaxError", 11) == 0) {
+                metrics_record_eval(wrapper, METRIC_SYNTAX_ERRORS);
+            } else if (msg && strcmp(msg, "InternalError: out of memory") == 0) {
+                metrics_record_eval(wrapper, METRIC_MEMORY_LIMIT_ERRORS);
+            } else {
+                metrics_record_eval(wrapper, METRIC_JAVASCRIPT_ERRORS);
+            }
+            rb_ary_push(args->rb_errors, rb_assoc_new(LONG2NUM(index),
+                                                       rb_utf8_str_new_cstr(msg ? msg : "JavaScript error")));
+            if (args->stop_on_error) {
+                break;
+            }
+        } else {
+            metrics_record_eval(wrapper, -1);
+            // JSON.stringify gives undefined for functions
+            if (value != JS_UNDEFINED) {
+                size_t out_len;
+                JSCStringBuf buf;
+                const char *out = JS_ToCStringLen(ctx, &out_len, value, &buf);
+                rb_str_cat(args->rb_output, out, out_len);
+                rb_str_cat(args->rb_output, "\n", 1);
+                args->written++;
+            }
+        }
+        line = next;
+    }
+    return Qnil;
+}
+
+static VALUE transform_done(VALUE arg) {
+    struct transform_args *args = (struct transform_args *)arg;
+
+    JS_PopGCRef(args->wrapper->ctx, &args->stringify_ref);
+    JS_PopGCRef(args->wrapper->ctx, &args->func_ref);
+    args->wrapper->running = 0;
+    ruby_xfree(args->lines);
+    return Qnil;
+}
+
+static VALUE transform_check_run(VALUE arg) {
+    sandbox_check_run((ContextWrapper *)arg, JS_EXCEPTION);
+    return Qnil;
+}
+
+// Returns [output, records, written, errors, exception ending the stream or nil].
+// Each record counts as one eval in MQuickJS.metrics, with its own duration.
+static VALUE sandbox_transform_lines(VALUE self, VALUE func_name, VALUE chunk, VALUE stop_on_error) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    check_can_eval(wrapper);
+    JSContext *ctx = wrapper->ctx;
+    const char *name = StringValueCStr(func_name);
+    StringValue(chunk);
+
+    JSValue global = JS_GetGlobalObject(ctx);
+    JSValue func = JS_GetPropertyStr(ctx, global, name);
+    if (JS_IsException(func) || !JS_IsFunction(ctx, func)) {
+        JS_GetException(ctx);
+        rb_raise(rb_eArgError, "'%s' is not a function", name);
+    }
+    struct transform_args args = { 0 };
+    args.wrapper = wrapper;
+    JS_PushGCRef(ctx, &args.func_ref)[0] = func;
+    JS_PushGCRef(ctx, &args.stringify_ref)[0] = JS_UNDEFINED;
+
+    JSValue json = JS_GetPropertyStr(ctx, JS_GetGlobalObject(ctx), "JSON");
+    JSValue stringify = JS_IsException(json) ? json : JS_GetPropertyStr(ctx, json, "stringify");
+    if (JS_IsException(stringify) || !JS_IsFunction(ctx, stringify)) {
+        JS_GetException(ctx);
+        JS_PopGCRef(ctx, &args.stringify_ref);
+        JS_PopGCRef(ctx, &args.func_ref);
+        rb_raise(rb_eRuntimeError, "JSON.stringify is not available in this sandbox");
+    }
+    args.stringify_ref.val = stringify;
+
+    // Console output is not returned, only kept from filling up
+    wrapper->console_output[0] = '\0';
+    wrapper->console_output_len = 0;
+    wrapper->console_truncated = 0;
+    wrapper->timed_out = 0;
+    wrapper->slice_deadline_ns = 0;
+    wrapper->eval_start_ns = get_time_ns();
+
+    args.len = RSTRING_LEN(chunk);
+    args.lines = ruby_xmalloc(args.len + 1);
+    memcpy(args.lines, RSTRING_PTR(chunk), args.len);
+    args.lines[args.len] = '\0';
+    args.stop_on_error = RTEST(stop_on_error);
+    args.rb_output = rb_str_buf_new(args.len);
+    rb_enc_associate(args.rb_output, rb_utf8_encoding());
+    args.rb_errors = rb_ary_new();
+
+    rb_ensure(transform_body, (VALUE)&args, transform_done, (VALUE)&args);
+
+    // A timeout or failing host callback ends the stream. Its exception
+    // is returned so the output of the records before it is written first.
+    VALUE rb_exception = Qnil;
+    if (wrapper->timed_out || !NIL_P(wrapper->rb_host_error)) {
+        int state;
+        rb_protect(transform_check_run, (VALUE)wrapper, &state);
+        rb_exception = rb_errinfo();
+        rb_set_errinfo(Qnil);
+    }
+    metrics_add(METRIC_BYTES_CONVERTED, RSTRING_LEN(args.rb_output));
+
+    return rb_ary_new_from_args(5, args.rb_output, LONG2NUM(args.records), LONG2NUM(args.written),
+                                args.rb_errors, rb_exception);
+}
+
+// Sandbox#start_profiling
+static VALUE sandbox_start_profiling(VALUE self, VALUE interval_us) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    if (!wrapper || !wrapper->ctx) {
+        rb_raise(rb_eRuntimeError, "Invalid sandbox state");
+    }
+
+    if (wrapper->profiling) {
+        rb_raise(rb_eRuntimeError, "Profiling is already active");
+    }
+
+    int64_t interval = NUM2LL(interval_us);
+    if (interval <= 0) {
+        rb_raise(rb_eArgError, "Profiling interval must be positive");
+    }
+
+    wrapper->rb_profile_samples = rb_hash_new();
+    wrapper->profile_interval_ns = interval * 1000;
+    wrapper->profiling = 1;
+
+    // Poll more often so samples land close to their due time
+    JS_SetInterruptPeriod(wrapper->ctx, PROFILE_INTERRUPT_PERIOD);
+
+    return Qnil;
+}
+
+// Sandbox#stop_profiling
+static VALUE sandbox_stop_profiling(VALUE self) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    if (!wrapper || !wrapper->ctx) {
+        rb_raise(rb_eRuntimeError, "Invalid sandbox state");
+    }
+
+    VALUE samples = wrapper->rb_profile_samples;
+    if (NIL_P(samples)) {
+        samples = rb_hash_new();
+    }
+
+    wrapper->profiling = 0;
+    wrapper->rb_profile_samples = Qnil;
+    JS_SetInterruptPeriod(wrapper->ctx, 0);
+
+    return samples;
+}
+
+// Sandbox#start_allocation_sampling
+static VALUE sandbox_start_allocation_sampling(VALUE self, VALUE sample_bytes) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    if (!wrapper || !wrapper->ctx) {
+        rb_raise(rb_eRuntimeError, "Invalid sandbox state");
+    }
+
+    if (!NIL_P(wrapper->rb_alloc_samples)) {
+        rb_raise(rb_eRuntimeError, "Allocation sampling is already active");
+    }
+
+    int64_t interval = NUM2LL(sample_bytes);
+    if (interval <= 0 || interval > UINT32_MAX) {
+        rb_raise(rb_eArgError, "Allocation sample interval must be between 1 and %u bytes", UINT32_MAX);
+    }
+
+    wrapper->rb_alloc_samples = rb_hash_new();
+    JS_SetAllocSampler(wrapper->ctx, alloc_sample_hook, (uint32_t)interval);
+
+    return Qnil;
+}
+
+// Sandbox#stop_allocation_sampling
+static VALUE sandbox_stop_allocation_sampling(VALUE self) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    if (!wrapper || !wrapper->ctx) {
+        rb_raise(rb_eRuntimeError, "Invalid sandbox state");
+    }
+
+    VALUE samples = wrapper->rb_alloc_samples;
+    if (NIL_P(samples)) {
+        samples = rb_hash_new();
+    }
+
+    JS_SetAllocSampler(wrapper->ctx, NULL, 0);
+    wrapper->rb_alloc_samples = Qnil;
+
+    return samples;
+}
+
+// NativeSandbox.opcode_stats_available?
+static VALUE sandbox_s_opcode_stats_available(VALUE klass) {
+    // Opcode names are only compiled in together with the counters
+    return JS_GetOpcodeName(0) != NULL ? Qtrue : Qfalse;
+}
+
+// Sandbox#start_opcode_stats
+static VALUE sandbox_start_opcode_stats(VALUE self) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    if (!wrapper || !wrapper->ctx) {
+        rb_raise(rb_eRuntimeError, "Invalid sandbox state");
+    }
+
+    if (wrapper->opcode_stats) {
+        rb_raise(rb_eRuntimeError, "Opcode statistics are already active");
+    }
+
+    if (JS_GetOpcodeName(0) == NULL) {
+        rb_raise(rb_eNotImpError,
+                 "Opcode statistics are not compiled in (rebuild with MQUICKJS_OPCODE_STATS=1)");
+    }
+
+    int n = JS_GetOpcodeCount();
+    struct JSOpcodeStatsBuf *buf = calloc(1, sizeof(*buf));
+    if (buf) {
+        buf->op_count = n;
+        buf->stats.op_count = calloc(n, sizeof(uint64_t));
+        buf->stats.op_pair_count = calloc((size_t)n * n, sizeof(uint64_t));
+    }
+    if (!buf || !buf->stats.op_count || !buf->stats.op_pair_count) {
+        opcode_stats_free(buf);
+        rb_raise(rb_eNoMemError, "Failed to allocate opcode counters");
+    }
+
+    wrapper->opcode_stats = buf;
+    JS_SetOpcodeStats(wrapper->ctx, &buf->stats);
+
+    return Qnil;
+}
+
+// Sandbox#stop_opcode_stats
+static VALUE sandbox_stop_opcode_stats(VALUE self) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    if (!wrapper || !wrapper->ctx) {
+        rb_raise(rb_eRuntimeError, "Invalid sandbox state");
+    }
+
+    VALUE opcodes = rb_hash_new();
+    VALUE pairs = rb_hash_new();
+    VALUE slow_paths = rb_hash_new();
+    VALUE result = rb_hash_new();
+    rb_hash_aset(result, ID2SYM(rb_intern("opcodes")), opcodes);
+    rb_hash_aset(result, ID2SYM(rb_intern("pairs")), pairs);
+    rb_hash_aset(result, ID2SYM(rb_intern("slow_paths")), slow_paths);
+
+    struct JSOpcodeStatsBuf *buf = wrapper->opcode_stats;
+    if (!buf) {
+        return result;
+    }
+
+    // The counters stay owned by the wrapper until the hashes are built,
+    // so sandbox_free() still releases them if building raises
+    JS_SetOpcodeStats(wrapper->ctx, NULL);
+
+    // Only executed opcodes and pairs are reported
+    int n = buf->op_count;
+    for (int op = 0; op < n; op++) {
+        if (buf->stats.op_count[op]) {
+            rb_hash_aset(opcodes, rb_str_new_cstr(JS_GetOpcodeName(op)),
+                         ULL2NUM(buf->stats.op_count[op]));
+        }
+    }
+    for (int i = 0; i < n * n; i++) {
+        uint64_t count = buf->stats.op_pair_count[i];
+        if (count) {
+            VALUE key = rb_ary_new_from_args(2, rb_str_new_cstr(JS_GetOpcodeName(i / n)),
+                                             rb_str_new_cstr(JS_GetOpcodeName(i % n)));
+            rb_hash_aset(pairs, key, ULL2NUM(count));
+        }
+    }
+    for (int i = 0; i < JS_SLOW_PATH_COUNT; i++) {
+        rb_hash_aset(slow_paths, rb_str_new_cstr(JS_GetSlowPathName(i)),
+                     ULL2NUM(buf->stats.slow_path_count[i]));
+    }
+
+    wrapper->opcode_stats = NULL;
+    opcode_stats_free(buf);
+
+    return result;
+}
+
+// NativeSandbox.metrics_snapshot
+static VALUE sandbox_s_metrics_snapshot(VALUE klass) {
+    // Collect under the lock so a concurrent reset cannot move the
+    // baseline past the collected totals
+    MetricsShard total;
+    pthread_mutex_lock(&metrics_reset_lock);
+    metrics_collect(&total);
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        total.counters[i] -= metrics_baseline.counters[i];
+    }
+    for (int h = 0; h < HISTOGRAM_COUNT; h++) {
+        for (int b = 0; b <= METRICS_BUCKET_COUNT; b++) {
+            total.buckets[h][b] -= metrics_baseline.buckets[h][b];
+        }
+        total.sums_ns[h] -= metrics_baseline.sums_ns[h];
+    }
+    pthread_mutex_unlock(&metrics_reset_lock);
+
+    VALUE counters = rb_hash_new();
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        rb_hash_aset(counters, ID2SYM(rb_intern(metric_names[i])), ULL2NUM(total.counters[i]));
+    }
+
+    // Histograms use cumulative Prometheus-style buckets keyed by upper bound
+    VALUE histograms = rb_hash_new();
+    for (int h = 0; h < HISTOGRAM_COUNT; h++) {
+        VALUE buckets = rb_hash_new();
+        uint64_t count = 0;
+        for (int b = 0; b <= METRICS_BUCKET_COUNT; b++) {
+            count += total.buckets[h][b];
+            VALUE bound = b < METRICS_BUCKET_COUNT
+                ? DBL2NUM(metrics_bucket_bounds_ns[b] / 1e9)
+                : DBL2NUM(HUGE_VAL);
+            rb_hash_aset(buckets, bound, ULL2NUM(count));
+        }
+
+        VALUE histogram = rb_hash_new();
+        rb_hash_aset(histogram, ID2SYM(rb_intern("buckets")), buckets);
+        rb_hash_aset(histogram, ID2SYM(rb_intern("sum")), DBL2NUM(total.sums_ns[h] / 1e9));
+        rb_hash_aset(histogram, ID2SYM(rb_intern("count")), ULL2NUM(count));
+        rb_hash_aset(histograms, ID2SYM(rb_intern(histogram_names[h])), histogram);
+    }
+
+    VALUE snapshot = rb_hash_new();
+    rb_hash_aset(snapshot, ID2SYM(rb_intern("counters")), counters);
+    rb_hash_aset(snapshot, ID2SYM(rb_intern("histograms")), histograms);
+    return snapshot;
+}
+
+// NativeSandbox.metrics_reset
+static VALUE sandbox_s_metrics_reset(VALUE klass) {
+    MetricsShard total;
+    pthread_mutex_lock(&metrics_reset_lock);
+    metrics_collect(&total);
+    memcpy(metrics_baseline.counters, total.counters, sizeof(total.counters));
+    memcpy(metrics_baseline.buckets, total.buckets, sizeof(total.buckets));
+    memcpy(metrics_baseline.sums_ns, total.sums_ns, sizeof(total.sums_ns));
+    pthread_mutex_unlock(&metrics_reset_lock);
+
+    return Qnil;
+}
+
+// Heap census (Sandbox#heap_census)
+static const char *const heap_class_names[JS_CLASS_USER] = {
+    "Object",
+    "Array",
+    "CFunction",
+    "Closure",
+    "Number",
+    "Boolean",
+    "String",
+    "Date",
+    "RegExp",
+    "Error",
+    "EvalError",
+    "RangeError",
+    "ReferenceError",
+    "SyntaxError",
+    "TypeError",
+    "URIError",
+    "InternalError",
+    "ArrayBuffer",
+    "TypedArray",
+    "Uint8ClampedArray",
+    "Int8Array",
+    "Uint8Array",
+    "Int16Array",
+    "Uint16Array",
+    "Int32Array",
+    "Uint32Array",
+    "Float32Array",
+    "Float64Array",
+};
+
+#define HEAP_CLASS_MAX 256  // JSObject.class_id is 8 bits
+
+struct heap_census {
+    uint64_t mtag_count[JS_MTAG_COUNT];
+    uint64_t mtag_bytes[JS_MTAG_COUNT];
+    uint64_t class_count[HEAP_CLASS_MAX];
+    uint64_t class_bytes[HEAP_CLASS_MAX];
+    VALUE mtag_names[JS_MTAG_COUNT];
+    VALUE class_names[HEAP_CLASS_MAX];
+    VALUE nodes;  // Only set for a full dump
+    VALUE edges;
+};
+
+static VALUE heap_class_name(int class_id) {
+    if (class_id < JS_CLASS_USER) {
+        return rb_str_new_cstr(heap_class_names[class_id]);
+    }
+    char buf[32];
+    snprintf(buf, sizeof(buf), "UserClass%d", class_id - JS_CLASS_USER);
+    return rb_str_new_cstr(buf);
+}
+
+static void heap_census_block_cb(void *opaque, const JSHeapBlock *block) {
+    struct heap_census *census = opaque;
+
+    census->mtag_count[block->mtag]++;
+    census->mtag_bytes[block->mtag] += block->size;
+    if (block->class_id >= 0) {
+        census->class_count[block->class_id]++;
+        census->class_bytes[block->class_id] += block->size;
+    }
+
+    if (!NIL_P(census->nodes)) {
+        // Names are shared frozen strings, the dump can hold millions of nodes
+        if (!census->mtag_names[block->mtag]) {
+            census->mtag_names[block->mtag] = rb_obj_freeze(rb_str_new_cstr(JS_GetMTagName(block->mtag)));
+        }
+        VALUE class_name = Qnil;
+        if (block->class_id >= 0) {
+            if (!census->class_names[block->class_id]) {
+                census->class_names[block->class_id] = rb_obj_freeze(heap_class_name(block->class_id));
+            }
+            class_name = census->class_names[block->class_id];
+        }
+        rb_ary_push(census->nodes, rb_ary_new_from_args(4, UINT2NUM(block->offset),
+                                                        census->mtag_names[block->mtag],
+                                                        class_name, UINT2NUM(block->size)));
+    }
+}
+
+static void heap_census_edge_cb(void *opaque, uint32_t from, uint32_t to) {
+    struct heap_census *census = opaque;
+    VALUE rb_from = from == JS_HEAP_ROOT ? Qnil : UINT2NUM(from);
+    rb_ary_push(census->edges, rb_ary_new_from_args(2, rb_from, UINT2NUM(to)));
+}
+
+static VALUE heap_census_entry(uint64_t count, uint64_t bytes) {
+    VALUE entry = rb_hash_new();
+    rb_hash_aset(entry, ID2SYM(rb_intern("count")), ULL2NUM(count));
+    rb_hash_aset(entry, ID2SYM(rb_intern("bytes")), ULL2NUM(bytes));
+    return entry;
+}
+
+// Sandbox#heap_census
+static VALUE sandbox_heap_census(VALUE self, VALUE rb_gc, VALUE rb_dump) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    if (!wrapper || !wrapper->ctx) {
+        rb_raise(rb_eRuntimeError, "Invalid sandbox state");
+    }
+
+    check_not_running(wrapper);
+
+    if (RTEST(rb_gc)) {
+        JS_GC(wrapper->ctx);
+    }
+
+    // Zeroed VALUE slots are filled lazily; the struct lives on the C
+    // stack, so Ruby's conservative stack scan keeps them alive
+    struct heap_census census;
+    memset(&census, 0, sizeof(census));
+    census.nodes = RTEST(rb_dump) ? rb_ary_new() : Qnil;
+    census.edges = RTEST(rb_dump) ? rb_ary_new() : Qnil;
+
+    JS_WalkHeap(wrapper->ctx, heap_census_block_cb,
+                RTEST(rb_dump) ? heap_census_edge_cb : NULL, &census);
+
+    VALUE mtags = rb_hash_new();
+    for (int i = 0; i < JS_MTAG_COUNT; i++) {
+        if (census.mtag_count[i]) {
+            rb_hash_aset(mtags, rb_str_new_cstr(JS_GetMTagName(i)),
+                         heap_census_entry(census.mtag_count[i], census.mtag_bytes[i]));
+        }
+    }
+
+    VALUE classes = rb_hash_new();
+    for (int i = 0; i < HEAP_CLASS_MAX; i++) {
+        if (census.class_count[i]) {
+            rb_hash_aset(classes, heap_class_name(i),
+                         heap_census_entry(census.class_count[i], census.class_bytes[i]));
+        }
+    }
+
+    JSMemoryUsage usage;
+    JS_GetMemoryUsage(wrapper->ctx, &usage);
+
+    VALUE result = rb_hash_new();
+    rb_hash_aset(result, ID2SYM(rb_intern("heap_size")), SIZET2NUM(usage.heap_size));
+    rb_hash_aset(result, ID2SYM(rb_intern("stack_size")), SIZET2NUM(usage.stack_size));
+    rb_hash_aset(result, ID2SYM(rb_intern("memory_limit")), SIZET2NUM(wrapper->mem_size));
+    rb_hash_aset(result, ID2SYM(rb_intern("mtags")), mtags);
+    rb_hash_aset(result, ID2SYM(rb_intern("classes")), classes);
+    rb_hash_aset(result, ID2SYM(rb_intern("nodes")), census.nodes);
+    rb_hash_aset(result, ID2SYM(rb_intern("edges")), census.edges);
+
+    RB_GC_GUARD(census.nodes);
+    RB_GC_GUARD(census.edges);
+    return result;
+}
+
+// Sandbox#creation_timings
+static VALUE sandbox_creation_timings(VALUE self) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    VALUE hash = rb_hash_new();
+    rb_hash_aset(hash, ID2SYM(rb_intern("arena_alloc_ms")), DBL2NUM(wrapper->arena_alloc_ns / 1e6));
+    rb_hash_aset(hash, ID2SYM(rb_intern("new_context_ms")), DBL2NUM(wrapper->new_context_ns / 1e6));
+    return hash;
+}
+
+// Sandbox#close
+static VALUE sandbox_close(VALUE self) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    check_not_running(wrapper);
+    if (wrapper->profiling || !NIL_P(wrapper->rb_alloc_samples)) {
+        rb_raise(rb_eRuntimeError, "Cannot close a sandbox while profiling");
+    }
+
+    sandbox_release(wrapper);
+    return Qnil;
+}
+
+// Sandbox#closed?
+static VALUE sandbox_closed_p(VALUE self) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    return wrapper->ctx ? Qfalse : Qtrue;
+}
+
+// Sandbox#memory_usage
+static VALUE sandbox_memory_usage(VALUE self, VALUE rb_reset_peak) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+
+    if (!wrapper || !wrapper->ctx) {
+        rb_raise(rb_eRuntimeError, "Invalid sandbox state");
+    }
+
+    JSMemoryUsage usage;
+    JS_GetMemoryUsage(wrapper->ctx, &usage);
+    if (usage.heap_size > wrapper->peak_heap_size) {
+        wrapper->peak_heap_size = usage.heap_size;
+    }
+
+    VALUE result = rb_hash_new();
+    rb_hash_aset(result, ID2SYM(rb_intern("heap_size")), SIZET2NUM(usage.heap_size));
+    rb_hash_aset(result, ID2SYM(rb_intern("peak_heap_size")), SIZET2NUM(wrapper->peak_heap_size));
+    rb_hash_aset(result, ID2SYM(rb_intern("stack_size")), SIZET2NUM(usage.stack_size));
+    rb_hash_aset(result, ID2SYM(rb_intern("memory_limit")), SIZET2NUM(wrapper->mem_size));
+
+    if (RTEST(rb_reset_peak)) {
+        wrapper->peak_heap_size = usage.heap_size;
+    }
+    return result;
+}
+
+// NativePrelude#initialize: compile the prelude in a scratch context
+// prepared for compilation (the stdlib atoms copied into its heap), copy
+// the bytecode out of that heap, then relocate the copy with a regular
+// context. Relocation points the copied stdlib atoms back at the stdlib's
+// own table, so the image holds only the prelude's functions, constants
+// and names.
+static VALUE prelude_initialize(VALUE self, VALUE code_str, VALUE filename, VALUE rb_memory_limit, VALUE rb_stdlib) {
+    PreludeImage *prelude;
+    TypedData_Get_Struct(self, PreludeImage, &prelude_type, prelude);
+
+    if (prelude->image) {
+        rb_raise(rb_eRuntimeError, "Prelude is already compiled");
+    }
+    const char *code = StringValueCStr(code_str);
+    size_t code_len = RSTRING_LEN(code_str);
+    const char *name = StringValueCStr(filename);
+    size_t memory_limit = NUM2SIZET(rb_memory_limit);
+    int stdlib_profile = stdlib_profile_index(rb_stdlib);
+    const JSSTDLibraryDef *stdlib = js_stdlib_profiles[stdlib_profile].def;
+
+    uint8_t *mem_buf = malloc(memory_limit);
+    if (!mem_buf) {
+        rb_raise(rb_eNoMemError, "Failed to allocate memory buffer");
+    }
+
+    // Errors thrown in a context prepared for compilation have no
+    // prototypes to format them, so check the code in a regular one first
+    JSContext *ctx = JS_NewContext(mem_buf, memory_limit, stdlib);
+    JSValue func = ctx ? JS_Parse(ctx, code, code_len, name, 0) : JS_EXCEPTION;
+    if (ctx && !JS_IsException(func)) {
+        JS_FreeContext(ctx);
+        ctx = JS_NewContext2(mem_buf, memory_limit, stdlib, TRUE);
+        func = ctx ? JS_Parse(ctx, code, code_len, name, 0) : JS_EXCEPTION;
+    }
+    if (!ctx || JS_IsException(func)) {
+        JSCStringBuf buf;
+        const char *msg = ctx ? JS_ToCString(ctx, JS_GetException(ctx), &buf) : NULL;
+        VALUE exception;
+        // The parser reports running out of memory as a syntax error
+        if (!msg || strcmp(msg, "InternalError: out of memory") == 0 ||
+            strcmp(msg, "SyntaxError: not enough memory") == 0) {
+            VALUE oom_argv[4] = {
+                rb_sprintf("Compiling the prelude needs more than %zu bytes (memory_limit)", memory_limit),
+                rb_str_new_cstr(""), Qfalse, Qnil
+            };
+            exception = rb_class_new_instance(4, oom_argv, rb_eMQuickJSMemoryLimitError);
+        } else {
+            VALUE argv[4] = { rb_str_new_cstr(msg), Qnil, rb_str_new_cstr(""), Qfalse };
+            exception = rb_class_new_instance(4, argv, rb_eMQuickJSSyntaxError);
+        }
+        if (ctx) {
+            JS_FreeContext(ctx);
+        }
+        free(mem_buf);
+        rb_exc_raise(exception);
+    }
+
+    JSBytecodeHeader hdr;
+    const uint8_t *data;
+    uint32_t data_len;
+    JS_PrepareBytecode(ctx, &hdr, &data, &data_len, func);
+
+    size_t image_size = sizeof(hdr) + data_len;
+    uint8_t *image = mmap(NULL, image_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    int failed = image == MAP_FAILED;
+    if (!failed) {
+        memcpy(image, &hdr, sizeof(hdr));
+        memcpy(image + sizeof(hdr), data, data_len);
+    }
+    JS_FreeContext(ctx);
+
+    if (!failed) {
+        ctx = JS_NewContext(mem_buf, memory_limit, stdlib);
+        failed = !ctx || JS_RelocateBytecode(ctx, image, image_size) != 0;
+        if (ctx) {
+            JS_FreeContext(ctx);
+        }
+        if (failed) {
+            munmap(image, image_size);
+        }
+    }
+    free(mem_buf);
+    if (failed) {
+        rb_raise(rb_eRuntimeError, "Failed to build the prelude image");
+    }
+
+    // Any write by a sandbox would be a bug, so make it fault
+    mprotect(image, image_size, PROT_READ);
+    prelude->image = image;
+    prelude->image_size = image_size;
+    prelude->stdlib_profile = stdlib_profile;
+    rb_obj_freeze(self);
+    return self;
+}
+
+// NativePrelude#bytesize
+static VALUE prelude_bytesize(VALUE self) {
+    PreludeImage *prelude;
+    TypedData_Get_Struct(self, PreludeImage, &prelude_type, prelude);
+
+    return SIZET2NUM(prelude->image_size);
+}
+
+// Sandbox#load_prelude: register the image's bytecode and run its top
+// level, which creates the prelude's globals in this sandbox's heap. The
+// engine accepts bytecode only before any atom is created in RAM, so
+// this has to come first.
+static VALUE sandbox_load_prelude(VALUE self, VALUE rb_prelude) {
+    ContextWrapper *wrapper;
+    TypedData_Get_Struct(self, ContextWrapper, &sandbox_type, wrapper);
+    PreludeImage *prelude;
+    TypedData_Get_Struct(rb_prelude, PreludeImage, &prelude_type, prelude);
+
+    if (!wrapper || !wrapper->ctx) {
+        rb_raise(rb_eRuntimeError, "Invalid sandbox state");
+    }
+    check_not_running(wrapper);
+    if (wrapper->prelude) {
+        rb_raise(rb_eRuntimeError, "Sandbox already has a prelude");
+    }
+    if (!prelude->image) {
+        rb_raise(rb_eRuntimeError, "Prelude is not compiled");
+    }
+    // The image's atoms point into the stdlib it was relocated for
+    if (prelude->stdlib_profile != wrapper->stdlib_profile) {
+        rb_raise(rb_eArgError, "Prelude was compiled for the '%s' stdlib, not '%s'",
+                 js_stdlib_profiles[prelude->stdlib_profile].name,
+                 js_stdlib_profiles[wrapper->stdlib_profile].name);
+    }
+
+    JSValue func = JS_LoadBytecode(wrapper->ctx, prelude->image);
+    if (JS_IsException(func)) {
+        JSCStringBuf buf;
+        const char *msg = JS_ToCString(wrapper->ctx, JS_GetException(wrapper->ctx), &buf);
+        rb_raise(rb_eRuntimeError, "Cannot attach the prelude: %s", msg ? msg : "unknown error");
+    }
+    wrapper->prelude = prelude_image_retain(prelude);
+
+    wrapper->console_output[0] = '\0';
+    wrapper->console_output_len = 0;
+    wrapper->console_truncated = 0;
+    wrapper->eval_start_ns = get_time_ns();
+    wrapper->start_time_ms = get_time_ms();
+    wrapper->timed_out = 0;
+    if (wrapper->collect_timings) {
+        memset(&wrapper->timings, 0, sizeof(wrapper->timings));
+    }
+
+    JSValue result = sandbox_run_js(wrapper, func, RUN_START);
+    return sandbox_finish_run(wrapper, result);
+}
+
+// NativeSandbox.stdlib_profiles
+static VALUE sandbox_s_stdlib_profiles(VALUE klass) {
+    VALUE names = rb_ary_new_capa(STDLIB_PROFILE_COUNT);
+    for (int i = 0; i < STDLIB_PROFILE_COUNT; i++) {
+        rb_ary_push(names, rb_str_new_cstr(js_stdlib_profiles[i].name));
+    }
+    return names;
+}
+
 // Module initialization
 void Init_mquickjs_native(void) {
+#ifdef HAVE_RB_EXT_RACTOR_SAFE
+    // All per-sandbox state lives in its ContextWrapper, the class and
+    // exception globals are set once here and the metrics shards are per
+    // native thread, so sandboxes can be created and used in any Ractor
+    rb_ext_ractor_safe(true);
+#endif
+
     // Define module and classes
     rb_cMQuickJS = rb_define_module("MQuickJS");
     rb_cSandbox = rb_define_class_under(rb_cMQuickJS, "NativeSandbox", rb_cObject);
@@ -895,7 +2676,37 @@ void Init_mquickjs_native(void) {
     // Define allocation and methods
     rb_define_alloc_func(rb_cSandbox, sandbox_alloc);
     rb_define_method(rb_cSandbox, "initialize", sandbox_initialize, -1);
-    rb_define_method(rb_cSandbox, "eval", sandbox_eval, 1);
+    rb_define_method(rb_cSandbox, "eval", sandbox_eval, 2);
+    rb_define_method(rb_cSandbox, "resume", sandbox_resume, 1);
+    rb_define_method(rb_cSandbox, "cancel", sandbox_cancel, 0);
+    rb_define_method(rb_cSandbox, "suspended?", sandbox_suspended_p, 0);
+    rb_define_method(rb_cSandbox, "impure?", sandbox_impure_p, 0);
+    rb_define_method(rb_cSandbox, "write_count", sandbox_write_count, 0);
     rb_define_method(rb_cSandbox, "set_variable", sandbox_set_variable, 2);
+    rb_define_method(rb_cSandbox, "transfer", sandbox_transfer, 3);
+    rb_define_method(rb_cSandbox, "transform_lines", sandbox_transform_lines, 3);
     rb_define_method(rb_cSandbox, "http_callback=", sandbox_set_http_callback, 1);
+    rb_define_method(rb_cSandbox, "start_profiling", sandbox_start_profiling, 1);
+    rb_define_method(rb_cSandbox, "stop_profiling", sandbox_stop_profiling, 0);
+    rb_define_method(rb_cSandbox, "start_allocation_sampling", sandbox_start_allocation_sampling, 1);
+    rb_define_method(rb_cSandbox, "stop_allocation_sampling", sandbox_stop_allocation_sampling, 0);
+    rb_define_singleton_method(rb_cSandbox, "opcode_stats_available?", sandbox_s_opcode_stats_available, 0);
+    rb_define_method(rb_cSandbox, "start_opcode_stats", sandbox_start_opcode_stats, 0);
+    rb_define_method(rb_cSandbox, "stop_opcode_stats", sandbox_stop_opcode_stats, 0);
+    rb_define_method(rb_cSandbox, "heap_census", sandbox_heap_census, 2);
+    rb_define_method(rb_cSandbox, "memory_usage", sandbox_memory_usage, 1);
+    rb_define_method(rb_cSandbox, "creation_timings", sandbox_creation_timings, 0);
+    rb_define_method(rb_cSandbox, "close", sandbox_close, 0);
+    rb_define_method(rb_cSandbox, "closed?", sandbox_closed_p, 0);
+    rb_define_singleton_method(rb_cSandbox, "metrics_snapshot", sandbox_s_metrics_snapshot, 0);
+    rb_define_singleton_method(rb_cSandbox, "metrics_reset", sandbox_s_metrics_reset, 0);
+    rb_define_method(rb_cSandbox, "load_prelude", sandbox_load_prelude, 1);
+    rb_define_singleton_method(rb_cSandbox, "stdlib_profiles", sandbox_s_stdlib_profiles, 0);
+
+    rb_cPrelude = rb_define_class_under(rb_cMQuickJS, "NativePrelude", rb_cObject);
+    rb_define_alloc_func(rb_cPrelude, prelude_alloc);
+    rb_define_method(rb_cPrelude, "initialize", prelude_initialize, 4);
+    rb_define_method(rb_cPrelude, "bytesize", prelude_bytesize, 0);
+
+    pthread_key_create(&metrics_shard_key, metrics_release_shard);
 }
@@ -3,10 +3,19 @@
 require_relative "mquickjs/version"
 require_relative "mquickjs/errors"
 require_relative "mquickjs/result"
+require_relative "mquickjs/result_cache"
+require_relative "mquickjs/profile"
+require_relative "mquickjs/allocation_profile"
+require_relative "mquickjs/opcode_stats"
+require_relative "mquickjs/heap_census"
+require_relative "mquickjs/metrics"
 require_relative "mquickjs/http_config"
 require_relative "mquickjs/http_executor"
 require_relative "mquickjs/mquickjs_native"
+require_relative "mquickjs/prelude"
 require_relative "mquickjs/sandbox"
+require_relative "mquickjs/worker_pool"
+require_relative "mquickjs/scheduler"
 
 module MQuickJS
   # Convenience method for one-shot evaluation
@@ -20,4 +29,15 @@ module MQuickJS
     sandbox = Sandbox.new(memory_limit: memory_limit, timeout_ms: timeout_ms, http: http)
     sandbox.eval(code)
   end
+
+  # Names of the standard library profiles compiled into the extension,
+  # for Sandbox.new(stdlib:)
+  #
+  # "full" has every builtin. The others are built from
+  # ext/mquickjs/profiles/<name>.txt, which lists the globals they keep.
+  #
+  # @return [Array<Symbol>]
+  def self.stdlib_profiles
+    NativeSandbox.stdlib_profiles.map(&:to_sym)
+  end
 end
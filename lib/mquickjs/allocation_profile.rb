@@ -0,0 +1,59 @@
+# frozen_string_literal: true
+
+module MQuickJS
+  # Allocation samples collected by Sandbox#allocation_profile
+  #
+  # One sample is taken every sample_bytes allocated bytes and attributed to
+  # the innermost JavaScript frame, labelled "name (file:line)", together with
+  # the allocation kind (mtag). Byte counts are estimates: samples multiplied
+  # by sample_bytes.
+  class AllocationProfile
+    attr_reader :sample_bytes, :value
+
+    def initialize(samples, sample_bytes:, value: nil)
+      @samples = samples
+      @sample_bytes = sample_bytes
+      @value = value
+    end
+
+    # Total number of samples taken
+    def samples
+      @samples.values.sum
+    end
+
+    # Estimated number of bytes allocated
+    def total_bytes
+      samples * @sample_bytes
+    end
+
+    # Estimated bytes per allocation site, with a per-mtag breakdown
+    #
+    # @return [Hash{String => Hash}] sorted by bytes, descending, e.g.
+    #   { "render (<eval>:12)" => { bytes: 81920, mtags: { "string" => 65536, ... } } }
+    def sites
+      stats = Hash.new { |hash, site| hash[site] = { bytes: 0, mtags: Hash.new(0) } }
+
+      @samples.each do |(site, mtag), count|
+        bytes = count * @sample_bytes
+        stats[site][:bytes] += bytes
+        stats[site][:mtags][mtag] += bytes
+      end
+
+      stats.each_value { |entry| entry[:mtags] = sort_by_bytes(entry[:mtags]) }
+      stats.sort_by { |site, entry| [-entry[:bytes], site] }.to_h
+    end
+
+    # Estimated bytes per mtag (object, string, value_array, ...), descending
+    def mtags
+      totals = Hash.new(0)
+      @samples.each { |(_site, mtag), count| totals[mtag] += count * @sample_bytes }
+      sort_by_bytes(totals)
+    end
+
+    private
+
+    def sort_by_bytes(totals)
+      totals.sort_by { |name, bytes| [-bytes, name] }.to_h
+    end
+  end
+end
@@ -38,10 +38,13 @@ module MQuickJS
 
   # Raised when memory limit is exceeded
   class MemoryLimitError < Error
-    attr_reader :console_output
+    attr_reader :stack, :console_output
 
-    def initialize(message = "Memory limit exceeded", console_output = nil, console_truncated = false)
+    # stack is the JavaScript backtrace at the allocation that failed
+    def initialize(message = "Memory limit exceeded", console_output = nil, console_truncated = false,
+                   stack = nil)
       super(message)
+      @stack = stack
       @console_output = console_output || ""
       @console_truncated = console_truncated
     end
@@ -53,11 +56,13 @@ module MQuickJS
 
   # Raised when execution timeout is exceeded
   class TimeoutError < Error
-    attr_reader :console_output
+    attr_reader :stack, :console_output
 
+    # stack is the JavaScript backtrace at the moment the deadline passed
     def initialize(message = "JavaScript execution timeout exceeded",
-                   console_output = nil, console_truncated = false)
+                   console_output = nil, console_truncated = false, stack = nil)
       super(message)
+      @stack = stack
       @console_output = console_output || ""
       @console_truncated = console_truncated
     end
@@ -112,6 +117,16 @@ module MQuickJS
     end
   end
 
+  # Raised by WorkerPool#eval when the worker running it crashed or did not
+  # answer in time. The pool has already replaced the worker.
+  class WorkerCrashedError < Error; end
+
+  # Raised by WorkerPool#eval when every worker is busy and the wait queue is full
+  class PoolBusyError < Error; end
+
+  # Raised by Scheduler::Job#value when the job had not finished by its deadline
+  class DeadlineExceededError < Error; end
+
   # Raised when invalid arguments are passed
   class ArgumentError < Error; end
 end
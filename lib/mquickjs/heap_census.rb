@@ -0,0 +1,78 @@
+# frozen_string_literal: true
+
+module MQuickJS
+  # Snapshot of a sandbox's JavaScript heap taken by Sandbox#heap_census
+  #
+  # Memory blocks are counted per mtag (the engine's allocation kind: object,
+  # string, float64, value_array for property and array storage, byte_array,
+  # func_bytecode, varref, free) and objects additionally per class.
+  #
+  # With dump: true the census also carries the full heap graph. Nodes are
+  # [id, mtag, class_name, bytes] (class_name is nil for non-objects) and
+  # edges are [from_id, to_id], where a nil from_id is a GC root.
+  class HeapCensus
+    attr_reader :heap_size, :stack_size, :memory_limit, :mtags, :classes, :nodes, :edges
+
+    def initialize(census)
+      @heap_size = census[:heap_size]
+      @stack_size = census[:stack_size]
+      @memory_limit = census[:memory_limit]
+      @mtags = sort_by_bytes(census[:mtags])
+      @classes = sort_by_bytes(census[:classes])
+      @nodes = census[:nodes]
+      @edges = census[:edges]
+    end
+
+    # Whether the heap graph (nodes and edges) was captured
+    def dump?
+      !@nodes.nil?
+    end
+
+    # Bytes that would be freed if the given node became unreachable: the
+    # node itself plus everything only reachable through it
+    #
+    # @param id [Integer] Node id
+    # @return [Integer]
+    def retained_size(id)
+      raise ArgumentError, "heap_census was taken without dump: true" unless dump?
+
+      without = reachable_from_roots(except: id)
+      live.each_key.sum { |node| without.key?(node) ? 0 : node_sizes.fetch(node) }
+    end
+
+    private
+
+    def sort_by_bytes(entries)
+      entries.sort_by { |name, entry| [-entry[:bytes], name] }.to_h
+    end
+
+    def node_sizes
+      @node_sizes ||= @nodes.to_h { |id, _mtag, _class_name, bytes| [id, bytes] }
+    end
+
+    def references
+      @references ||= @edges.each_with_object(Hash.new { |hash, id| hash[id] = [] }) do |(from, to), refs|
+        refs[from] << to
+      end
+    end
+
+    def live
+      @live ||= reachable_from_roots
+    end
+
+    # Set (as a Hash) of the node ids reachable from the GC roots without
+    # passing through the node 'except'
+    def reachable_from_roots(except: nil)
+      seen = {}
+      pending = references[nil].dup
+      until pending.empty?
+        id = pending.pop
+        next if id == except || seen.key?(id)
+
+        seen[id] = true
+        pending.concat(references[id]) if references.key?(id)
+      end
+      seen
+    end
+  end
+end
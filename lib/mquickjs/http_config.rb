@@ -13,7 +13,8 @@ module MQuickJS
     DEFAULT_ALLOWED_METHODS = %w[GET POST PUT DELETE PATCH HEAD].freeze
     DEFAULT_ALLOWED_PORTS = [80, 443].freeze
 
-    # Private IP ranges (RFC 1918) and other blocked ranges
+    # Private IP ranges (RFC 1918) and other blocked ranges. Frozen deeply so
+    # the constant is shareable and sandboxes can make requests in any Ractor.
     BLOCKED_IP_RANGES = [
       "10.0.0.0/8",          # Private
       "172.16.0.0/12",       # Private
@@ -23,7 +24,7 @@ module MQuickJS
       "::1/128",             # IPv6 loopback
       "fe80::/10",           # IPv6 link-local
       "169.254.169.254/32"   # AWS/GCP/Azure metadata
-    ].map { |cidr| IPAddr.new(cidr) }.freeze
+    ].map { |cidr| IPAddr.new(cidr).freeze }.freeze
 
     attr_reader :allowlist, :denylist, :max_requests, :request_timeout,
                 :max_request_size, :max_response_size, :allowed_methods,
@@ -69,14 +70,12 @@ module MQuickJS
     def blocked_ip?(ip_or_host)
       return false unless @block_private_ips
 
-      # Resolve hostname to IP if needed
-      ip_str = resolve_to_ip(ip_or_host)
-      return false unless ip_str
-
-      ip = IPAddr.new(ip_str)
-
-      # Check against blocked ranges
-      BLOCKED_IP_RANGES.any? { |range| range.include?(ip) }
+      # Resolve hostname to IPs if needed. The connection may use any of
+      # them, so one blocked address blocks the host.
+      resolve_to_ips(ip_or_host).any? do |ip_str|
+        ip = IPAddr.new(ip_str)
+        BLOCKED_IP_RANGES.any? { |range| range.include?(ip) }
+      end
     rescue IPAddr::InvalidAddressError, SocketError
       # If we can't parse/resolve, block it to be safe
       true
@@ -138,23 +137,25 @@ module MQuickJS
       end
     end
 
-    # Resolve hostname to IP address
-    def resolve_to_ip(host)
+    # Resolve hostname to all of its IP addresses
+    def resolve_to_ips(host)
       # If it's already an IP, return it
       begin
         IPAddr.new(host)
-        return host
+        return [host]
       rescue IPAddr::InvalidAddressError
         # Not an IP, continue to DNS resolution
       end
 
-      # Resolve DNS
-      begin
-        require "resolv"
-        Resolv.getaddress(host)
-      rescue Resolv::ResolvError
-        nil
+      # Resolve DNS. In a non-blocking fiber, let the Fiber.scheduler do
+      # it so other fibers keep running during the lookup.
+      scheduler = Fiber.scheduler
+      if scheduler && !Fiber.current.blocking? && scheduler.respond_to?(:address_resolve)
+        return Array(scheduler.address_resolve(host))
       end
+
+      require "resolv"
+      Resolv.getaddresses(host)
     end
   end
 
@@ -0,0 +1,62 @@
+# frozen_string_literal: true
+
+module MQuickJS
+  # Process-wide counters and histograms aggregated across every sandbox
+  #
+  # Updated from the native extension at the end of each eval (successful or
+  # not), on every garbage collection, string conversion and fetch() call.
+  # Each thread writes its own shard without locking; a snapshot sums them.
+  #
+  # Counters: evals, syntax_errors, javascript_errors, timeouts,
+  # memory_limit_errors, fetch_errors, gc_runs, bytes_converted (string bytes
+  # crossing the Ruby/JavaScript boundary) and fetch_requests.
+  #
+  # Histograms: eval_duration_seconds and gc_duration_seconds, with cumulative
+  # buckets keyed by upper bound in seconds (the last one is Float::INFINITY).
+  module Metrics
+    module_function
+
+    # @return [Hash] { counters: { evals: 42, ... },
+    #   histograms: { eval_duration_seconds: { buckets: { 5.0e-05 => 3, ... }, sum: 0.12, count: 42 }, ... } }
+    def snapshot
+      NativeSandbox.metrics_snapshot
+    end
+
+    # Restart all counters and histograms from zero
+    def reset
+      NativeSandbox.metrics_reset
+      nil
+    end
+
+    # Snapshot in the Prometheus text exposition format
+    #
+    # @param prefix [String] Metric name prefix (default: "mquickjs")
+    # @return [String]
+    def to_prometheus(prefix: "mquickjs")
+      data = snapshot
+      lines = []
+
+      data[:counters].each do |name, value|
+        lines << "# TYPE #{prefix}_#{name}_total counter"
+        lines << "#{prefix}_#{name}_total #{value}"
+      end
+
+      data[:histograms].each do |name, histogram|
+        lines << "# TYPE #{prefix}_#{name} histogram"
+        histogram[:buckets].each do |bound, count|
+          le = bound.infinite? ? "+Inf" : bound.to_s
+          lines << "#{prefix}_#{name}_bucket{le=\"#{le}\"} #{count}"
+        end
+        lines << "#{prefix}_#{name}_sum #{histogram[:sum]}"
+        lines << "#{prefix}_#{name}_count #{histogram[:count]}"
+      end
+
+      lines.join("\n") << "\n"
+    end
+  end
+
+  # Process-wide metrics registry, see Metrics
+  def self.metrics
+    Metrics
+  end
+end
@@ -0,0 +1,40 @@
+# frozen_string_literal: true
+
+module MQuickJS
+  # Interpreter counters collected by Sandbox#opcode_stats
+  #
+  # Only opcodes and opcode pairs that actually executed are present.
+  # Slow paths are the fallbacks taken when an operation's inline fast path
+  # (small integers, plain arrays, own properties) does not apply.
+  class OpcodeStats
+    attr_reader :opcodes, :pairs, :slow_paths, :value
+
+    def initialize(stats, value: nil)
+      @opcodes = sort_by_count(stats[:opcodes])
+      @pairs = sort_by_count(stats[:pairs])
+      @slow_paths = sort_by_count(stats[:slow_paths])
+      @value = value
+    end
+
+    # Total number of opcodes executed
+    def total
+      @opcodes.values.sum
+    end
+
+    # Total number of slow-path entries
+    def slow_path_total
+      @slow_paths.values.sum
+    end
+
+    # The n most frequent opcode pairs, as [[first, second], count]
+    def top_pairs(n = 10)
+      @pairs.first(n)
+    end
+
+    private
+
+    def sort_by_count(counts)
+      counts.sort_by { |key, count| [-count, key] }.to_h
+    end
+  end
+end
@@ -0,0 +1,49 @@
+# frozen_string_literal: true
+
+module MQuickJS
+  # JavaScript compiled once into a read-only bytecode image that any
+  # number of sandboxes can share
+  #
+  # A sandbox created with Sandbox.new(prelude:) runs the prelude's top
+  # level when it is created, but its functions' bytecode, constant strings
+  # and property names stay in the shared image: only the objects the top
+  # level creates (function objects, globals) are allocated in the
+  # sandbox's heap, and nothing is parsed again. Each sandbox still gets
+  # its own globals, so one sandbox changing a prelude variable does not
+  # affect another.
+  #
+  # A Prelude is frozen and can be shared with other Ractors. The image is
+  # freed once the Prelude and every sandbox using it are gone.
+  #
+  # @example
+  #   helpers = MQuickJS::Prelude.new(File.read("helpers.js"), filename: "helpers.js")
+  #   sandbox = MQuickJS::Sandbox.new(prelude: helpers)
+  #   sandbox.eval("chunk([1, 2, 3, 4], 2)").value  # => [[1, 2], [3, 4]]
+  class Prelude
+    attr_reader :filename, :stdlib
+
+    # @param code [String] JavaScript to compile
+    # @param filename [String] Name used in stack traces
+    # @param memory_limit [Integer, nil] Heap size for compiling, in bytes
+    #   (default: 32 bytes per byte of code, at least 1MB)
+    # @param stdlib [Symbol] Stdlib profile of the sandboxes it will be attached to (default: :full)
+    # @raise [SyntaxError] Invalid JavaScript syntax
+    # @raise [MemoryLimitError] The code does not compile within memory_limit
+    # @raise [ArgumentError] Unknown stdlib profile
+    def initialize(code, filename: "<prelude>", memory_limit: nil, stdlib: :full)
+      memory_limit ||= [code.bytesize * 32, 1_000_000].max
+      @filename = -filename.to_s
+      @stdlib = stdlib.to_sym
+      @native = NativePrelude.new(code, @filename, memory_limit, @stdlib)
+      freeze
+    end
+
+    # Size of the bytecode image, in bytes
+    def bytesize
+      @native.bytesize
+    end
+
+    # @api private
+    attr_reader :native
+  end
+end
@@ -0,0 +1,55 @@
+# frozen_string_literal: true
+
+module MQuickJS
+  # Samples collected by Sandbox#profile
+  #
+  # Each sample is the JavaScript call stack at the moment the profiler
+  # fired, recorded as a collapsed stack: frames from outermost to innermost,
+  # separated by ";", each labelled "name (file:line)" or "name (native)".
+  class Profile
+    attr_reader :stacks, :interval_us, :value
+
+    def initialize(stacks, interval_us:, value: nil)
+      @stacks = stacks
+      @interval_us = interval_us
+      @value = value
+    end
+
+    # Total number of samples taken
+    def samples
+      @stacks.values.sum
+    end
+
+    # Collapsed-stack text, one "stack count" line per unique stack,
+    # as consumed by flamegraph.pl, speedscope and inferno
+    def collapsed_stacks
+      @stacks.sort_by { |stack, count| [-count, stack] }
+              .map { |stack, count| "#{stack} #{count}\n" }
+              .join
+    end
+
+    # Per-function sample counts, keyed by "name (file)" or "name (native)"
+    #
+    # :self counts samples where the function was executing, :total counts
+    # samples where it was anywhere on the stack (recursion counted once).
+    #
+    # @return [Hash{String => Hash{Symbol => Integer}}] sorted by total, descending
+    def functions
+      stats = Hash.new { |hash, name| hash[name] = { self: 0, total: 0 } }
+
+      @stacks.each do |stack, count|
+        frames = stack.split(";").map { |frame| function_name(frame) }
+        stats[frames.last][:self] += count
+        frames.uniq.each { |name| stats[name][:total] += count }
+      end
+
+      stats.sort_by { |name, counts| [-counts[:total], name] }.to_h
+    end
+
+    private
+
+    def function_name(frame)
+      frame.sub(/:\d+\)\z/, ")")
+    end
+  end
+end
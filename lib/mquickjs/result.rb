@@ -5,15 +5,36 @@ module MQuickJS
   class Result
     attr_reader :value, :console_output, :http_requests
 
-    def initialize(value, console_output, console_truncated, http_requests = [])
+    # Where the eval's time went, or nil unless the sandbox was created with
+    # timings: true
+    #
+    # Keys: :parse_ms, :run_ms, :convert_ms (result conversion to Ruby) and
+    # :total_ms (their sum), plus :gc_ms/:gc_count/:gc_max_ms (longest pause)
+    # and :host_ms/:host_calls (console and fetch callbacks), which overlap
+    # with parse and run.
+    #
+    # @return [Hash{Symbol => Float, Integer}, nil]
+    attr_reader :timings
+
+    def initialize(value, console_output, console_truncated, http_requests = [], timings = nil, suspended = false)
       @value = value
       @console_output = console_output
       @console_truncated = console_truncated
       @http_requests = http_requests
+      @timings = timings
+      @suspended = suspended
     end
 
     def console_truncated?
       @console_truncated
     end
+
+    # Whether the eval stopped at the end of its time slice (Sandbox#eval
+    # with slice_ms:) instead of finishing. The value is then nil and the
+    # console output is what the script printed so far; Sandbox#resume
+    # continues it.
+    def suspended?
+      @suspended
+    end
   end
 end
@@ -0,0 +1,119 @@
+# frozen_string_literal: true
+
+require "digest"
+
+module MQuickJS
+  # Bounded LRU of eval results, keyed by script and inputs, behind
+  # Sandbox.new(memoize:)
+  #
+  # Cached results are deep-frozen, since every hit hands out the same
+  # objects.
+  #
+  # A result can depend on any global, so the cache is emptied whenever
+  # the sandbox's state may have changed behind it: the engine counts
+  # every write to a global and every write an eval makes to an object
+  # that existed before it started (see #sync), and code run outside a
+  # cached eval invalidates it. The one exception is an eval's own
+  # variables, which are part of its key: setting them only drops the
+  # entries that do not set the same names themselves.
+  class ResultCache
+    attr_reader :max_size, :write_count
+
+    # Cache key for code evaluated after setting variables, or nil when
+    # the variables cannot be encoded (e.g. a Hash with a default proc)
+    #
+    # The variables are encoded with Marshal, which keeps hash key order:
+    # a script can observe it through Object.keys, so differently ordered
+    # inputs are different inputs.
+    def self.key(code, variables)
+      Digest::SHA256.digest(Marshal.dump([code, variables]))
+    rescue TypeError
+      nil
+    end
+
+    # @param max_size [Integer] Entries kept before the least recently used is evicted
+    def initialize(max_size)
+      raise ArgumentError, "memoize must be a positive Integer (got #{max_size.inspect})" unless
+        max_size.is_a?(Integer) && max_size.positive?
+
+      @max_size = max_size
+      @entries = {}
+      @variable_names = {}
+      @write_count = nil
+      @stats = { hits: 0, misses: 0, impure: 0, evictions: 0, invalidations: 0 }
+    end
+
+    # Empty the cache if the sandbox's write counter moved since the last
+    # call
+    def sync(write_count)
+      invalidate unless write_count == @write_count
+      @write_count = write_count
+    end
+
+    # Account for an eval setting its variables names, which moved the
+    # write counter to write_count: entries that do not set all of these
+    # names may have read them, so they are dropped
+    def variables_set(names, write_count)
+      stale = @variable_names.reject { |_, entry_names| (names - entry_names).empty? }.keys
+      stale.each do |key|
+        @entries.delete(key)
+        @variable_names.delete(key)
+      end
+      @write_count = write_count
+    end
+
+    # Drop every entry, as globals may have changed
+    def invalidate
+      return if @entries.empty?
+
+      clear
+      @stats[:invalidations] += 1
+    end
+
+    # The cached result for key, marking it most recently used
+    def lookup(key)
+      result = @entries.delete(key)
+      if result
+        @entries[key] = result
+        @stats[:hits] += 1
+      else
+        @stats[:misses] += 1
+      end
+      result
+    end
+
+    # Cache result under key, evicting the least recently used entry when
+    # full
+    #
+    # @param variable_names [Array<String>] Globals the eval set before running
+    # @return [Result] The result, now deep-frozen
+    def store(key, result, variable_names = [])
+      @entries[key] = Ractor.make_shareable(result)
+      @variable_names[key] = variable_names
+      if @entries.size > @max_size
+        evicted, = @entries.shift
+        @variable_names.delete(evicted)
+        @stats[:evictions] += 1
+      end
+      result
+    end
+
+    # Count a result that was not cached because the script called an
+    # impure builtin, wrote a global or modified an existing object, which
+    # also invalidates the cache
+    def skip_impure
+      @stats[:impure] += 1
+      invalidate
+    end
+
+    def clear
+      @entries.clear
+      @variable_names.clear
+    end
+
+    # @return [Hash] :hits, :misses, :impure, :evictions, :invalidations, :size, :max_size
+    def stats
+      @stats.merge(size: @entries.size, max_size: @max_size)
+    end
+  end
+end
@@ -1,5 +1,7 @@
 # frozen_string_literal: true
 
+require "json"
+
 module MQuickJS
   # Sandbox provides a secure JavaScript execution environment.
   #
@@ -12,6 +14,11 @@ module MQuickJS
     # @param timeout_ms [Integer] Execution timeout in milliseconds (default: 5,000)
     # @param console_log_max_size [Integer] Console output limit in bytes (default: 10,000)
     # @param http [Hash, nil] HTTP configuration options (enables fetch() in JavaScript)
+    # @param timings [Boolean] Record a per-eval timing breakdown in Result#timings (default: false)
+    # @param memoize [Integer, nil] Cache up to this many results of pure evals (default: nil, no cache)
+    # @param prelude [Prelude, nil] Shared compiled library whose top level runs first
+    # @param stdlib [Symbol] Standard library profile, one of MQuickJS.stdlib_profiles (default: :full)
+    # @param symbolize_keys [Boolean] Give Hashes in results Symbol keys instead of frozen Strings (default: false)
     #
     # @option http [Array<String>] :allowlist URL patterns to allow (e.g., ['https://api.github.com/**'])
     # @option http [Array<String>] :denylist URL patterns to block (allows all others)
@@ -45,48 +52,406 @@ module MQuickJS
     #   )
     #   result = sandbox.eval("fetch('https://safe-api.com/data').body")
     #
-    def initialize(memory_limit: 50_000, timeout_ms: 5000, console_log_max_size: 10_000, http: nil)
+    # @example A smaller context for pure computation
+    #   sandbox = MQuickJS::Sandbox.new(stdlib: :minimal)
+    #   sandbox.eval("typeof Date")  # => "undefined"
+    #
+    # @example Memoizing a pure pricing rule
+    #   sandbox = MQuickJS::Sandbox.new(memoize: 1000)
+    #   sandbox.eval(File.read("price.js"))
+    #   sandbox.eval("price(order)", variables: { "order" => order }).value
+    #
+    def initialize(memory_limit: 50_000, timeout_ms: 5000, console_log_max_size: 10_000, http: nil, timings: false,
+                   memoize: nil, prelude: nil, stdlib: :full, symbolize_keys: false)
       # The C code requires memory_limit >= 1024 bytes, but in practice the JavaScript
       # standard library initialization requires approximately 10KB. Using a value less
       # than this will cause the sandbox to fail during initialization.
       raise ArgumentError, "memory_limit cannot be less than 10000 bytes (got #{memory_limit})" if memory_limit < 10_000
+      if prelude && !prelude.is_a?(Prelude)
+        raise ArgumentError, "prelude must be a MQuickJS::Prelude (got #{prelude.class})"
+      end
 
       @native_sandbox = NativeSandbox.new(
         memory_limit: memory_limit,
         timeout_ms: timeout_ms,
-        console_log_max_size: console_log_max_size
+        console_log_max_size: console_log_max_size,
+        timings: timings,
+        stdlib: stdlib,
+        symbolize_keys: symbolize_keys
       )
+      # First, as the engine only accepts bytecode before any atom is created
+      @native_sandbox.load_prelude(prelude.native) if prelude
 
       @http_config = nil
       @http_executor = nil
+      @result_cache = memoize && ResultCache.new(memoize)
 
       setup_http(http) if http
     end
 
     # Evaluate JavaScript code in the sandbox
     #
+    # With slice_ms, the script runs for about that long and is then
+    # suspended instead of finishing: the returned Result is suspended? and
+    # #resume continues the script where it stopped. Suspension happens at
+    # the next loop iteration of JavaScript code called from the top level,
+    # so a slice can overrun while a callback of a built-in (e.g. the
+    # function passed to Array.prototype.map) or a regexp is running.
+    #
+    # In a sandbox created with memoize:, an eval without slice_ms first
+    # looks up the code and variables in the result cache. On a hit nothing
+    # runs: the cached (frozen) Result is returned and the variables are not
+    # set. A result is cached unless the eval called Date.now,
+    # performance.now, Math.random or fetch, wrote a global variable,
+    # modified an object or array it did not create itself (e.g.
+    # list.push(x) or cfg.n++ on a global), or raised. Such an eval, and
+    # any other write to the sandbox (#set_variable, #transfer into this
+    # sandbox, an eval that is not cached), empties the cache.
+    #
     # @param code [String] JavaScript code to execute
+    # @param slice_ms [Integer, nil] Suspend after this many milliseconds (default: run to completion)
+    # @param variables [Hash, nil] Global variables to set first, as with #set_variable
     # @return [Result] Result object with value, console_output, etc.
     # @raise [SyntaxError] Invalid JavaScript syntax
     # @raise [JavascriptError] JavaScript runtime error
     # @raise [MemoryLimitError] Memory limit exceeded
     # @raise [TimeoutError] Execution timeout
     # @raise [HTTPError] HTTP security violation (when HTTP is enabled)
-    def eval(code)
-      reset_http_executor if @http_executor
-      @native_sandbox.eval(code)
+    # @raise [RuntimeError] An earlier eval is still suspended
+    def eval(code, slice_ms: nil, variables: nil)
+      return memoized_eval(code, variables) if @result_cache && slice_ms.nil?
+
+      @result_cache&.invalidate
+      run(code, slice_ms, variables)
+    end
+
+    # Counters of the result cache, or nil unless the sandbox was created
+    # with memoize:
+    #
+    # @return [Hash, nil] :hits, :misses, :impure (results not cached because
+    #   the eval was impure), :evictions, :size, :max_size
+    def memo_stats
+      @result_cache&.stats
+    end
+
+    # Continue a suspended eval for another time slice
+    #
+    # The timeout counts running time only, summed over all slices. Console
+    # output accumulates until the eval finishes, and fetch() request
+    # limits apply to the whole eval.
+    #
+    # @param slice_ms [Integer, nil] Suspend again after this many milliseconds (default: run to completion)
+    # @return [Result] The eval's result, or a Result that is suspended? again
+    # @raise [RuntimeError] No eval is suspended
+    # @raise [Error] Anything #eval raises
+    #
+    # @example Time-slicing a long script
+    #   result = sandbox.eval(long_script, slice_ms: 10)
+    #   result = sandbox.resume(slice_ms: 10) while result.suspended?
+    #   result.value
+    def resume(slice_ms: nil)
+      @result_cache&.invalidate
+      @native_sandbox.resume(slice_ms)
+    end
+
+    # Whether an eval is suspended, waiting for #resume or #cancel
+    def suspended?
+      @native_sandbox.suspended?
+    end
+
+    # Abandon the suspended eval, unwinding its frames so the sandbox can
+    # eval again. Globals it already assigned keep their values.
+    #
+    # @return [Boolean] true if an eval was suspended
+    def cancel
+      @native_sandbox.cancel
     end
 
     # Set a global variable in the sandbox from Ruby
     #
     # @param name [String] Variable name
     # @param value [Object] Ruby value (nil, boolean, number, string, array, or hash)
+    # @raise [ArgumentError] value is nested more than 1000 levels deep (e.g. cyclic)
     def set_variable(name, value)
       @native_sandbox.set_variable(name, value)
     end
 
+    # Evaluate value_expr and copy its value into another sandbox as the
+    # global variable name, without converting it to Ruby objects
+    #
+    # The value is copied from one JavaScript heap to the other like a
+    # structured clone: numbers, strings, arrays and plain objects (own
+    # properties, without their prototype). A string or object reached
+    # several times is copied once, so shared references and cycles are
+    # kept. The copy counts against the target's memory limit.
+    #
+    # @param value_expr [String] JavaScript expression evaluated in this sandbox
+    # @param to [Sandbox] Sandbox receiving the value
+    # @param as [String, Symbol] Name of the global variable to set in the target
+    # @return [nil]
+    # @raise [JavascriptError] value_expr raised, or its value contains a
+    #   function, a getter or another kind of object
+    # @raise [MemoryLimitError] The copy does not fit in the target
+    # @raise [Error] Anything #eval raises
+    #
+    # @example Hand a parsed document to another tenant's sandbox
+    #   parser.transfer("parse(input)", to: renderer, as: "doc")
+    #   renderer.eval("render(doc)")
+    def transfer(value_expr, to:, as:)
+      raise ArgumentError, "to must be a MQuickJS::Sandbox (got #{to.class})" unless to.is_a?(Sandbox)
+
+      reset_http_executor if @http_executor
+      @result_cache&.invalidate
+      @native_sandbox.transfer(value_expr, to.native_sandbox, as.to_s)
+    end
+
+    # Run a JavaScript function over every record of a JSON Lines stream
+    #
+    # input_io is read in chunk_size blocks. Each non-blank line is parsed
+    # by the engine's JSON parser, passed to the global function named
+    # function_name, and its return value serialized with JSON.stringify
+    # into the output, one line per record. A function returning undefined
+    # drops the record. Nothing is converted to Ruby objects on the way,
+    # and console output is discarded.
+    #
+    # The timeout applies to each record. A record that fails to parse or
+    # whose function throws is handled according to errors:
+    # - :raise (default): raise JavascriptError naming the line, after
+    #   writing the output of the lines before it
+    # - :skip: count it in :errors and go on
+    # - an IO: also write {"line": <number>, "error": <message>} to it
+    #
+    # Each record counts as one eval in MQuickJS.metrics, and a failed
+    # one also counts under its error class.
+    #
+    # @param function_name [String] Global function taking one record
+    # @param input_io [IO] Source of JSON Lines, read with #read(chunk_size)
+    # @param output_io [IO] Destination of the results, written with #write
+    # @param errors [Symbol, IO] :raise, :skip, or an IO receiving error records
+    # @param chunk_size [Integer] Bytes read from input_io at a time (default: 64KB)
+    # @yield [stats] The counters so far, after each chunk (optional)
+    # @return [Hash] :lines, :records, :written, :errors, :bytes_read, :bytes_written
+    # @raise [JavascriptError] A record failed with errors: :raise
+    # @raise [TimeoutError] A record took longer than timeout_ms
+    # @raise [ArgumentError] function_name is not a function
+    #
+    # @example
+    #   sandbox.eval("function enrich(r) { if (r.total > 0) return { id: r.id, cents: r.total * 100 }; }")
+    #   File.open("in.ndjson") do |input|
+    #     File.open("out.ndjson", "w") { |output| sandbox.transform_stream("enrich", input, output, errors: :skip) }
+    #   end
+    #   # => { lines: 100000, records: 100000, written: 99120, errors: 3, bytes_read: 8388608, bytes_written: 2961021 }
+    def transform_stream(function_name, input_io, output_io, errors: :raise, chunk_size: 65_536)
+      unless %i[raise skip].include?(errors) || errors.respond_to?(:write)
+        raise ArgumentError, "errors must be :raise, :skip or an IO (got #{errors.inspect})"
+      end
+
+      stats = { lines: 0, records: 0, written: 0, errors: 0, bytes_read: 0, bytes_written: 0 }
+      pending = "".b
+      while (chunk = input_io.read(chunk_size))
+        stats[:bytes_read] += chunk.bytesize
+        pending << chunk
+        last_newline = pending.rindex("\n")
+        next unless last_newline
+
+        transform_chunk(function_name, pending.byteslice(0, last_newline + 1), output_io, errors, stats)
+        pending = pending.byteslice(last_newline + 1, pending.bytesize)
+        yield stats if block_given?
+      end
+      unless pending.empty?
+        transform_chunk(function_name, pending, output_io, errors, stats)
+        yield stats if block_given?
+      end
+      stats
+    end
+
+    # Profile the JavaScript evaluated inside the block with a sampling profiler
+    #
+    # Samples are taken from the interpreter's interrupt polling, so a sample
+    # is due every interval_us but lands on the next function call, loop
+    # iteration or regexp step. Time spent in Ruby (e.g. fetch callbacks) is
+    # not sampled.
+    #
+    # @param interval_us [Integer] Sampling interval in microseconds (default: 1000)
+    # @yield [sandbox] Block evaluating the code to profile
+    # @return [Profile] Collected samples; Profile#value holds the block's return value
+    #
+    # @example
+    #   profile = sandbox.profile { |s| s.eval(slow_script) }
+    #   File.write("out.folded", profile.collapsed_stacks)
+    #   profile.functions.first  # => ["fib (<eval>)", { self: 412, total: 498 }]
+    def profile(interval_us: 1000)
+      @native_sandbox.start_profiling(interval_us)
+      begin
+        value = yield(self)
+      ensure
+        stacks = @native_sandbox.stop_profiling
+      end
+      Profile.new(stacks, interval_us: interval_us, value: value)
+    end
+
+    # Sample the allocations made by the JavaScript evaluated inside the block
+    #
+    # Every sample_bytes allocated bytes, the allocation is attributed to the
+    # innermost JavaScript frame (function and line) and its kind (mtag).
+    #
+    # @param sample_bytes [Integer] Allocated bytes between two samples (default: 4096)
+    # @yield [sandbox] Block evaluating the code to profile
+    # @return [AllocationProfile] Collected samples; AllocationProfile#value holds the block's return value
+    #
+    # @example
+    #   profile = sandbox.allocation_profile { |s| s.eval(script) }
+    #   profile.sites.first  # => ["render (<eval>:12)", { bytes: 81920, mtags: { "string" => 65536, ... } }]
+    def allocation_profile(sample_bytes: 4096)
+      @native_sandbox.start_allocation_sampling(sample_bytes)
+      begin
+        value = yield(self)
+      ensure
+        samples = @native_sandbox.stop_allocation_sampling
+      end
+      AllocationProfile.new(samples, sample_bytes: sample_bytes, value: value)
+    end
+
+    # Count the memory blocks of the JavaScript heap per allocation kind
+    # (mtag) and per object class
+    #
+    # @param gc [Boolean] Collect garbage first so only live blocks are counted (default: true)
+    # @param dump [Boolean] Also capture the heap graph for retained-size analysis (default: false)
+    # @return [HeapCensus]
+    #
+    # @example
+    #   census = sandbox.heap_census
+    #   census.classes.first  # => ["Object", { count: 1200, bytes: 57600 }]
+    #   census.mtags["string"]  # => { count: 3400, bytes: 108800 }
+    def heap_census(gc: true, dump: false)
+      HeapCensus.new(@native_sandbox.heap_census(gc, dump))
+    end
+
+    # Current and peak size of the JavaScript heap, in bytes
+    #
+    # Cheap enough to call after every eval: unlike #heap_census it does not
+    # walk the heap. The peak is sampled before each garbage collection.
+    #
+    # @param reset_peak [Boolean] Restart peak tracking from the current size (default: false)
+    # @return [Hash] :heap_size, :peak_heap_size, :stack_size, :memory_limit
+    #
+    # @example
+    #   sandbox.memory_usage  # => { heap_size: 41216, peak_heap_size: 98304, stack_size: 512, memory_limit: 1000000 }
+    def memory_usage(reset_peak: false)
+      @native_sandbox.memory_usage(reset_peak)
+    end
+
+    # Time spent creating this sandbox, in milliseconds
+    #
+    # @return [Hash] :arena_alloc_ms (malloc of the memory_limit arena) and
+    #   :new_context_ms (JS_NewContext, including standard library setup)
+    def creation_timings
+      @native_sandbox.creation_timings
+    end
+
+    # Free the JavaScript context and its memory_limit arena now instead of
+    # when the sandbox is garbage collected. Any later call other than
+    # #close and #closed? raises RuntimeError.
+    #
+    # @return [nil]
+    def close
+      @native_sandbox.close
+    end
+
+    def closed?
+      @native_sandbox.closed?
+    end
+
+    # Whether the native extension was built with opcode counters
+    # (MQUICKJS_OPCODE_STATS=1), which Sandbox#opcode_stats requires
+    def self.opcode_stats_available?
+      NativeSandbox.opcode_stats_available?
+    end
+
+    # Count the opcodes, opcode pairs and slow-path entries executed by the
+    # JavaScript evaluated inside the block
+    #
+    # @yield [sandbox] Block evaluating the code to measure
+    # @return [OpcodeStats] Collected counters; OpcodeStats#value holds the block's return value
+    # @raise [NotImplementedError] The extension was built without opcode counters
+    #
+    # @example
+    #   stats = sandbox.opcode_stats { |s| s.eval(script) }
+    #   stats.top_pairs(3)  # => [[["get_loc", "push_i8"], 90210], ...]
+    #   stats.slow_paths    # => { "get_field" => 1204, "add" => 37, ... }
+    def opcode_stats
+      @native_sandbox.start_opcode_stats
+      begin
+        value = yield(self)
+      ensure
+        stats = @native_sandbox.stop_opcode_stats
+      end
+      OpcodeStats.new(stats, value: value)
+    end
+
+    protected
+
+    attr_reader :native_sandbox
+
     private
 
+    def run(code, slice_ms, variables)
+      variables&.each { |name, value| @native_sandbox.set_variable(name.to_s, value) }
+      reset_http_executor if @http_executor
+      @native_sandbox.eval(code, slice_ms)
+    end
+
+    def transform_chunk(function_name, chunk, output_io, errors, stats)
+      reset_http_executor if @http_executor
+      @result_cache&.invalidate
+      output, records, written, failures, exception = @native_sandbox.transform_lines(function_name, chunk,
+                                                                                      errors == :raise)
+      unless output.empty?
+        output_io.write(output)
+        stats[:bytes_written] += output.bytesize
+      end
+      raise exception if exception
+
+      stats[:records] += records
+      stats[:written] += written
+      stats[:errors] += failures.size
+
+      failures.each do |index, message|
+        line = stats[:lines] + index + 1
+        raise JavascriptError, "line #{line}: #{message}" if errors == :raise
+
+        errors.write("#{JSON.generate({ line: line, error: message })}\n") unless errors == :skip
+      end
+      stats[:lines] += chunk.count("\n")
+      stats[:lines] += 1 unless chunk.end_with?("\n")
+    end
+
+    def memoized_eval(code, variables)
+      key = ResultCache.key(code, variables)
+      unless key
+        @result_cache.invalidate
+        return run(code, nil, variables)
+      end
+
+      # Globals written since the last eval (set_variable, a transfer into
+      # this sandbox, an eval that was not cached) invalidate every entry
+      @result_cache.sync(@native_sandbox.write_count)
+      cached = @result_cache.lookup(key)
+      return cached if cached
+
+      names = variables ? variables.keys.map(&:to_s) : []
+      variables&.each { |name, value| @native_sandbox.set_variable(name.to_s, value) }
+      @result_cache.variables_set(names, @native_sandbox.write_count) unless names.empty?
+
+      result = run(code, nil, nil)
+      if @native_sandbox.impure? || @native_sandbox.write_count != @result_cache.write_count
+        @result_cache.skip_impure
+        result
+      else
+        @result_cache.store(key, result, names)
+      end
+    end
+
     def setup_http(http_options)
       @http_config = HTTPConfig.new(http_options)
       @http_executor = HTTPExecutor.new(@http_config)
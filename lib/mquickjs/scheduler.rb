@@ -0,0 +1,408 @@
+# frozen_string_literal: true
+
+module MQuickJS
+  # Runs many tenants' scripts on a fixed set of threads, one time quantum
+  # at a time, so a tenant with long scripts cannot starve the others
+  #
+  # Each job is evaluated with Sandbox#eval(slice_ms:) and continued with
+  # Sandbox#resume, so a thread runs one quantum of a job and then picks
+  # the next job to run.
+  #
+  # - Fairness: weighted fair queuing. Each tenant has a virtual time
+  #   that advances by the CPU time of its quanta divided by its weight,
+  #   and the runnable tenant with the lowest virtual time runs next. A
+  #   tenant of weight 2 gets twice the CPU of a tenant of weight 1 while
+  #   both have work. A tenant becoming active again starts at the
+  #   current virtual time, so idle time is not banked as credit.
+  # - Budgets: a tenant with cpu_budget_ms gets at most that much CPU per
+  #   budget_period_ms (a token bucket refilled continuously). A tenant
+  #   out of budget is throttled until the bucket refills.
+  # - Deadlines: a tenant's jobs run earliest deadline first, then in
+  #   submission order. A job still unfinished at its deadline is
+  #   cancelled before its next quantum and raises
+  #   DeadlineExceededError. Fairness between tenants comes before
+  #   deadlines.
+  #
+  # CPU time is the thread CPU time of each quantum. Sandbox#eval holds
+  # the GVL, so more than one thread only helps while scripts wait on
+  # fetch(); for parallel CPU use a scheduler per Ractor or a WorkerPool.
+  #
+  # A job either brings its own sandbox, which must not be used elsewhere
+  # until the job is done, or gets a fresh Sandbox built from
+  # sandbox_options and closed when the job ends. Jobs sharing a sandbox
+  # run one at a time.
+  #
+  # @example
+  #   scheduler = MQuickJS::Scheduler.new(threads: 4, quantum_ms: 10)
+  #   scheduler.tenant("free", weight: 1, cpu_budget_ms: 100)
+  #   scheduler.tenant("paid", weight: 4)
+  #   job = scheduler.submit(script, tenant: "paid", deadline_ms: 500)
+  #   job.value.value
+  #   scheduler.stats["paid"]  # => { cpu_ms: 12.4, queue_delay_ms: 3.1, ... }
+  class Scheduler
+    # One submitted script
+    class Job
+      attr_reader :tenant, :code, :sandbox, :deadline
+
+      # Thread CPU time spent running this job, in milliseconds
+      attr_reader :cpu_ms
+
+      # Time this job spent runnable but waiting for a thread, in milliseconds
+      attr_reader :queue_delay_ms
+
+      # Number of quanta this job has run
+      attr_reader :quanta
+
+      # @api private
+      attr_accessor :runnable_since, :started
+
+      def initialize(tenant, code, sandbox, deadline, owns_sandbox)
+        @tenant = tenant
+        @code = code
+        @sandbox = sandbox
+        @deadline = deadline
+        @owns_sandbox = owns_sandbox
+        @cpu_ms = 0.0
+        @queue_delay_ms = 0.0
+        @quanta = 0
+        @started = false
+        @runnable_since = Scheduler.now
+        @lock = Mutex.new
+        @finished = ConditionVariable.new
+        @done = false
+      end
+
+      # Wait for the job to finish
+      #
+      # @return [Result]
+      # @raise [DeadlineExceededError] The job missed its deadline
+      # @raise [Error] Anything Sandbox#eval raises
+      def value
+        @lock.synchronize { @finished.wait(@lock) until @done }
+        raise @error if @error
+
+        @result
+      end
+
+      def done?
+        @lock.synchronize { @done }
+      end
+
+      # @api private
+      def owns_sandbox?
+        @owns_sandbox
+      end
+
+      # @api private
+      def waited(delay_ms)
+        @queue_delay_ms += delay_ms
+      end
+
+      # @api private
+      def ran(cpu_ms)
+        @cpu_ms += cpu_ms
+        @quanta += 1
+      end
+
+      # @api private
+      def finish(result: nil, error: nil)
+        @lock.synchronize do
+          @result = result
+          @error = error
+          @done = true
+          @finished.broadcast
+        end
+      end
+    end
+
+    # Per-tenant scheduling state and counters
+    class Tenant
+      attr_reader :name, :jobs
+      attr_accessor :weight, :cpu_budget_ms, :vtime, :tokens, :refilled_at, :running,
+                    :submitted, :completed, :failed, :expired, :throttled, :was_throttled,
+                    :cpu_ms, :quanta, :queue_delay_ms, :max_queue_delay_ms
+
+      def initialize(name, weight, cpu_budget_ms)
+        @name = name
+        @weight = weight
+        @cpu_budget_ms = cpu_budget_ms
+        @jobs = []
+        @vtime = 0.0
+        @tokens = cpu_budget_ms.to_f
+        @refilled_at = Scheduler.now
+        @running = 0
+        @submitted = @completed = @failed = @expired = @throttled = @quanta = 0
+        @was_throttled = false
+        @cpu_ms = @queue_delay_ms = @max_queue_delay_ms = 0.0
+      end
+
+      def active?
+        !@jobs.empty? || @running.positive?
+      end
+
+      def stats
+        {
+          weight: @weight, cpu_budget_ms: @cpu_budget_ms,
+          queued: @jobs.size, running: @running,
+          submitted: @submitted, completed: @completed, failed: @failed, expired: @expired,
+          cpu_ms: @cpu_ms.round(3), quanta: @quanta, throttled: @throttled,
+          queue_delay_ms: @queue_delay_ms.round(3),
+          mean_queue_delay_ms: @quanta.zero? ? 0.0 : (@queue_delay_ms / @quanta).round(3),
+          max_queue_delay_ms: @max_queue_delay_ms.round(3)
+        }
+      end
+    end
+
+    attr_reader :quantum_ms
+
+    # @param threads [Integer] Threads running quanta (default: 1)
+    # @param quantum_ms [Integer] Length of one time quantum in milliseconds (default: 10)
+    # @param budget_period_ms [Integer] Period over which cpu_budget_ms applies (default: 1000)
+    # @param sandbox_options [Hash] Sandbox.new options for jobs submitted without a sandbox
+    def initialize(threads: 1, quantum_ms: 10, budget_period_ms: 1000, sandbox_options: {})
+      raise ArgumentError, "threads must be positive" unless threads.positive?
+      raise ArgumentError, "quantum_ms must be positive" unless quantum_ms.positive?
+
+      @quantum_ms = quantum_ms
+      @budget_period_ms = budget_period_ms.to_f
+      @sandbox_options = sandbox_options
+      @lock = Mutex.new
+      @available = ConditionVariable.new
+      @tenants = {}
+      @busy_sandboxes = {}.compare_by_identity
+      @vtime = 0.0
+      @closed = false
+      @threads = Array.new(threads) { Thread.new { run } }
+    end
+
+    # Add a tenant or change its weight and CPU budget
+    #
+    # Tenants named in #submit without being added first get weight 1 and
+    # no budget.
+    #
+    # @param name [String] Tenant name
+    # @param weight [Numeric] Share of CPU relative to other tenants (default: 1)
+    # @param cpu_budget_ms [Numeric, nil] CPU allowed per budget_period_ms (default: unlimited)
+    def tenant(name, weight: 1, cpu_budget_ms: nil)
+      raise ArgumentError, "weight must be positive" unless weight.positive?
+
+      @lock.synchronize do
+        tenant = (@tenants[name] ||= Tenant.new(name, weight, cpu_budget_ms))
+        if cpu_budget_ms && (tenant.cpu_budget_ms.nil? || tenant.tokens > cpu_budget_ms)
+          tenant.tokens = cpu_budget_ms.to_f
+          tenant.refilled_at = Scheduler.now
+        end
+        tenant.weight = weight
+        tenant.cpu_budget_ms = cpu_budget_ms
+        @available.broadcast
+      end
+      nil
+    end
+
+    # Queue a script
+    #
+    # @param code [String] JavaScript code to evaluate
+    # @param tenant [String] Tenant the job is accounted to
+    # @param sandbox [Sandbox, nil] Sandbox to evaluate in (default: a fresh one from sandbox_options)
+    # @param deadline_ms [Numeric, nil] Cancel the job if it has not finished this many
+    #   milliseconds after submission
+    # @return [Job]
+    def submit(code, tenant:, sandbox: nil, deadline_ms: nil)
+      deadline = deadline_ms && Scheduler.now + deadline_ms / 1000.0
+      job = Job.new(tenant, code, sandbox || Sandbox.new(**@sandbox_options), deadline, sandbox.nil?)
+
+      @lock.synchronize do
+        raise Error, "Scheduler is shut down" if @closed
+
+        state = (@tenants[tenant] ||= Tenant.new(tenant, 1, nil))
+        # A tenant coming back from idle starts at the current virtual
+        # time instead of spending credit saved while it had no work
+        state.vtime = [state.vtime, @vtime].max unless state.active?
+        state.submitted += 1
+        enqueue(state, job)
+        @available.signal
+      end
+      job
+    end
+
+    # Per-tenant counters since the scheduler started
+    #
+    # @return [Hash{String => Hash}] For each tenant: :weight, :cpu_budget_ms,
+    #   :queued, :running, :submitted, :completed, :failed, :expired (missed
+    #   their deadline), :cpu_ms, :quanta, :throttled (times it ran out of
+    #   budget), and :queue_delay_ms/:mean_queue_delay_ms/:max_queue_delay_ms
+    #   (time its jobs waited for a thread: total, per quantum, longest)
+    def stats
+      @lock.synchronize { @tenants.transform_values(&:stats) }
+    end
+
+    # Stop the threads after their current quanta. Jobs that have not
+    # finished raise Error from Job#value.
+    def shutdown
+      @lock.synchronize do
+        @closed = true
+        @available.broadcast
+      end
+      @threads.each(&:join)
+
+      jobs = @lock.synchronize do
+        @tenants.each_value.flat_map { |tenant| tenant.jobs.dup.tap { tenant.jobs.clear } }
+      end
+      jobs.each { |job| abandon(job, Error.new("Scheduler is shut down")) }
+      nil
+    end
+
+    def closed?
+      @closed
+    end
+
+    # @api private
+    def self.now
+      Process.clock_gettime(Process::CLOCK_MONOTONIC)
+    end
+
+    private
+
+    # Thread main loop: run one quantum of the next job, then requeue it
+    # or finish it
+    def run
+      while (job = next_job)
+        state = nil
+        cpu_start = Process.clock_gettime(Process::CLOCK_THREAD_CPUTIME_ID, :float_millisecond)
+        begin
+          result = job.started ? job.sandbox.resume(slice_ms: @quantum_ms) : job.sandbox.eval(job.code, slice_ms: @quantum_ms)
+        rescue StandardError => e
+          error = e
+        end
+        job.started = true
+        cpu_ms = Process.clock_gettime(Process::CLOCK_THREAD_CPUTIME_ID, :float_millisecond) - cpu_start
+
+        @lock.synchronize do
+          state = @tenants[job.tenant]
+          state.running -= 1
+          state.cpu_ms += cpu_ms
+          state.tokens -= cpu_ms if state.cpu_budget_ms
+          state.vtime += cpu_ms / state.weight
+          if !error && result.suspended?
+            job.runnable_since = Scheduler.now
+            enqueue(state, job)
+          else
+            @busy_sandboxes.delete(job.sandbox)
+            error ? state.failed += 1 : state.completed += 1
+          end
+          @available.broadcast
+        end
+        job.ran(cpu_ms)
+
+        # eval holds the GVL, so let submitting and waiting threads in
+        # between quanta
+        if !error && result.suspended?
+          Thread.pass
+          next
+        end
+
+        job.sandbox.close if job.owns_sandbox?
+        error ? job.finish(error: error) : job.finish(result: result)
+      end
+    end
+
+    # Pick the next job by weighted fair queuing, waiting while nothing is
+    # runnable. Returns nil once the scheduler is shut down.
+    def next_job
+      @lock.synchronize do
+        loop do
+          return nil if @closed
+
+          expire_jobs
+          now = Scheduler.now
+          refill_at = nil
+          pick = nil
+
+          @tenants.each_value do |tenant|
+            next if tenant.jobs.empty?
+
+            if tenant.cpu_budget_ms
+              refill(tenant, now)
+              if tenant.tokens <= 0
+                tenant.throttled += 1 unless tenant.was_throttled
+                tenant.was_throttled = true
+                wait_s = -tenant.tokens / tenant.cpu_budget_ms * @budget_period_ms / 1000.0
+                refill_at = [refill_at, now + wait_s].compact.min
+                next
+              end
+              tenant.was_throttled = false
+            end
+
+            job = tenant.jobs.find { |candidate| !@busy_sandboxes.key?(candidate.sandbox) || candidate.started }
+            next unless job
+
+            key = [tenant.vtime, job.deadline || Float::INFINITY]
+            pick = [key, tenant, job] if pick.nil? || (key <=> pick[0]).negative?
+          end
+
+          if pick
+            _key, tenant, job = pick
+            tenant.jobs.delete(job)
+            tenant.running += 1
+            @busy_sandboxes[job.sandbox] = true
+            @vtime = tenant.vtime
+            delay_ms = (now - job.runnable_since) * 1000
+            tenant.quanta += 1
+            tenant.queue_delay_ms += delay_ms
+            tenant.max_queue_delay_ms = delay_ms if delay_ms > tenant.max_queue_delay_ms
+            job.waited(delay_ms)
+            return job
+          end
+
+          timeout = [refill_at && refill_at - now, next_deadline && next_deadline - now].compact.min
+          timeout ? @available.wait(@lock, [timeout, 0.001].max) : @available.wait(@lock)
+        end
+      end
+    end
+
+    # Keep each tenant's queue in deadline order; jobs without a deadline
+    # go last, in submission order
+    def enqueue(tenant, job)
+      key = job.deadline || Float::INFINITY
+      index = tenant.jobs.index { |queued| (queued.deadline || Float::INFINITY) > key }
+      tenant.jobs.insert(index || tenant.jobs.size, job)
+    end
+
+    def refill(tenant, now)
+      elapsed_ms = (now - tenant.refilled_at) * 1000
+      tenant.refilled_at = now
+      tenant.tokens = [tenant.tokens + elapsed_ms * tenant.cpu_budget_ms / @budget_period_ms,
+                       tenant.cpu_budget_ms.to_f].min
+    end
+
+    def next_deadline
+      @tenants.each_value.filter_map { |tenant| tenant.jobs.first&.deadline }.min
+    end
+
+    # Cancel queued jobs whose deadline has passed. Called with @lock held;
+    # jobs are only ever queued between quanta, so no thread is using
+    # their sandbox.
+    def expire_jobs
+      now = Scheduler.now
+      @tenants.each_value do |tenant|
+        expired = tenant.jobs.select { |job| job.deadline && job.deadline <= now }
+        next if expired.empty?
+
+        tenant.jobs.reject! { |job| expired.include?(job) }
+        expired.each do |job|
+          tenant.expired += 1
+          # Only a started job holds its sandbox: an unstarted one may be
+          # queued behind another job suspended on the same sandbox
+          @busy_sandboxes.delete(job.sandbox) if job.started
+          abandon(job, DeadlineExceededError.new("Job missed its deadline after #{job.quanta} quanta"))
+        end
+      end
+    end
+
+    def abandon(job, error)
+      job.sandbox.cancel if job.started
+      job.sandbox.close if job.owns_sandbox?
+      job.finish(error: error)
+    end
+  end
+end
@@ -0,0 +1,317 @@
+# frozen_string_literal: true
+
+require "etc"
+require "io/wait"
+
+module MQuickJS
+  # Runs JavaScript in a pool of forked worker processes, to use every core
+  # for CPU-bound scripts
+  #
+  # The parent builds one sandbox and evaluates the prelude in it before
+  # forking, so each worker starts from a copy-on-write clone of that warmed
+  # template instead of parsing the prelude again. Requests and results
+  # travel over a pair of pipes per worker as length-prefixed Marshal
+  # frames.
+  #
+  # A worker that crashes or stops answering is killed and replaced; the
+  # eval it was running raises WorkerCrashedError. Workers are also
+  # replaced after max_evals evals or once their RSS passes max_rss.
+  #
+  # By default a worker keeps its sandbox between evals, like a reused
+  # Sandbox, so globals one caller leaves behind are visible to the next.
+  # Do not share such a pool between tenants. With isolate: true each eval
+  # runs in a throwaway fork of the warmed worker instead, and always starts
+  # from the template, at the cost of a fork per eval.
+  #
+  # #eval is thread-safe and blocks while every worker is busy. With
+  # max_queue callers already waiting it raises PoolBusyError instead, so a
+  # slow pool pushes back on its callers rather than queueing without bound.
+  #
+  # @example
+  #   pool = MQuickJS::WorkerPool.new(size: 4, prelude: File.read("transform.js"),
+  #                                   sandbox: { memory_limit: 1_000_000 })
+  #   pool.eval("transform(input)", variables: { "input" => payload }).value
+  #   pool.shutdown
+  class WorkerPool
+    Worker = Struct.new(:pid, :requests, :responses, :evals)
+
+    # Raised by read_frame when a frame is not complete by its deadline
+    ReadTimeout = Class.new(StandardError)
+    private_constant :ReadTimeout
+
+    attr_reader :size
+
+    # @param size [Integer] Number of worker processes (default: number of CPUs)
+    # @param sandbox [Hash] Options for Sandbox.new in the template
+    # @param prelude [String, nil] JavaScript evaluated once in the template before forking
+    # @param max_evals [Integer, nil] Replace a worker after this many evals (default: 1000)
+    # @param max_rss [Integer, nil] Replace a worker whose RSS grows past this many bytes
+    # @param max_queue [Integer] Callers allowed to wait for a worker before #eval
+    #   raises PoolBusyError (default: size * 4)
+    # @param reply_timeout [Float] Seconds to wait for a worker's answer before
+    #   killing it (default: the sandbox timeout plus 5 seconds)
+    # @param isolate [Boolean] Run each eval in a fresh fork of the template, so
+    #   no state is shared between evals (default: false)
+    def initialize(size: nil, sandbox: {}, prelude: nil, max_evals: 1000, max_rss: nil,
+                   max_queue: nil, reply_timeout: nil, isolate: false)
+      raise NotImplementedError, "WorkerPool needs Process.fork" unless Process.respond_to?(:fork)
+
+      @size = size || Etc.nprocessors
+      raise ArgumentError, "size must be positive" unless @size.positive?
+
+      @template = Sandbox.new(**sandbox)
+      @template.eval(prelude) if prelude
+      @max_evals = max_evals
+      @max_rss = max_rss
+      @max_queue = max_queue || @size * 4
+      @reply_timeout = reply_timeout || sandbox.fetch(:timeout_ms, 5000) / 1000.0 + 5
+      @isolate = isolate
+
+      @lock = Mutex.new
+      @available = ConditionVariable.new
+      @waiting = 0
+      @stats = { evals: 0, crashes: 0, recycled: 0 }
+      @workers = []
+      @size.times { @workers << spawn_worker }
+      @idle = @workers.dup
+      @closed = false
+    end
+
+    # Evaluate code in the next free worker
+    #
+    # @param code [String] JavaScript code to execute
+    # @param variables [Hash] Global variables to set first, as with Sandbox#set_variable
+    # @return [Result]
+    # @raise [PoolBusyError] max_queue callers are already waiting for a worker
+    # @raise [WorkerCrashedError] The worker died or did not answer in time
+    # @raise [TypeError] variables holds a value that cannot be marshaled
+    # @raise [Error] Anything Sandbox#eval raises
+    def eval(code, variables: {})
+      # Marshal first, so a request that cannot be sent never takes a worker
+      request = Marshal.dump([code, variables])
+      worker = checkout
+      finished = crashed = false
+      begin
+        status, payload, rss = call(worker, request)
+        finished = true
+      rescue WorkerCrashedError
+        crashed = true
+        raise
+      ensure
+        # A round trip cut short, by a crash or by Thread#raise, may leave
+        # half a request or an unread reply in the pipes: never reuse it
+        if finished
+          worker.evals += 1
+          if (@max_evals && worker.evals >= @max_evals) || (@max_rss && rss > @max_rss)
+            replace(worker)
+          else
+            checkin(worker)
+          end
+        else
+          replace(worker, crashed: crashed)
+        end
+      end
+
+      raise payload if status == :error
+
+      payload
+    end
+
+    # Counters since the pool started
+    #
+    # @return [Hash] :size, :busy, :waiting, :evals, :crashes, :recycled
+    def stats
+      @lock.synchronize do
+        @stats.merge(size: @size, busy: @workers.size - @idle.size, waiting: @waiting)
+      end
+    end
+
+    # Stop every worker. Evals already running finish first.
+    def shutdown
+      workers = @lock.synchronize do
+        @closed = true
+        @available.broadcast
+        @available.wait(@lock) until @idle.size == @workers.size
+        @workers.dup
+      end
+      workers.each { |worker| stop(worker) }
+      @template.close
+      nil
+    end
+
+    def closed?
+      @closed
+    end
+
+    private
+
+    def checkout
+      @lock.synchronize do
+        raise Error, "WorkerPool is shut down" if @closed
+        raise PoolBusyError, "All #{@size} workers are busy and #{@waiting} callers are waiting" if
+          @idle.empty? && @waiting >= @max_queue
+
+        @waiting += 1
+        begin
+          @available.wait(@lock) while @idle.empty? && !@closed
+        ensure
+          @waiting -= 1
+        end
+        raise Error, "WorkerPool is shut down" if @closed
+
+        @stats[:evals] += 1
+        @idle.shift
+      end
+    end
+
+    def checkin(worker)
+      @lock.synchronize do
+        @idle << worker
+        @available.broadcast
+      end
+    end
+
+    # Stop a worker and put a fresh fork of the template in its place
+    def replace(worker, crashed: false)
+      stop(worker)
+      fresh = spawn_worker
+      @lock.synchronize do
+        @stats[crashed ? :crashes : :recycled] += 1
+        @workers[@workers.index(worker)] = fresh
+        @idle << fresh
+        @available.broadcast
+      end
+    end
+
+    def call(worker, request)
+      write_frame(worker.requests, request)
+      deadline = Process.clock_gettime(Process::CLOCK_MONOTONIC) + @reply_timeout
+      read_frame(worker.responses, deadline) or raise WorkerCrashedError, "Worker #{worker.pid} exited unexpectedly"
+    rescue ReadTimeout
+      raise WorkerCrashedError, "Worker #{worker.pid} did not answer within #{@reply_timeout}s"
+    rescue Errno::EPIPE, Errno::ECONNRESET
+      raise WorkerCrashedError, "Worker #{worker.pid} exited unexpectedly"
+    end
+
+    def spawn_worker
+      request_reader, request_writer = IO.pipe
+      response_reader, response_writer = IO.pipe
+      [request_reader, request_writer, response_reader, response_writer].each(&:binmode)
+
+      siblings = @lock.synchronize { @workers.dup }
+      pid = fork do
+        request_writer.close
+        response_reader.close
+        siblings.each do |other|
+          other.requests.close unless other.requests.closed?
+          other.responses.close unless other.responses.closed?
+        end
+        serve(request_reader, response_writer)
+      end
+
+      request_reader.close
+      response_writer.close
+      Worker.new(pid, request_writer, response_reader, 0)
+    end
+
+    # Worker process main loop. Exits with exit! so the parent's at_exit
+    # handlers never run in a worker.
+    def serve(requests, responses)
+      while (request = read_frame(requests))
+        unless @isolate
+          write_frame(responses, evaluate(request, rss))
+          next
+        end
+
+        # The child answers and exits, leaving this process's template
+        # untouched. If it dies without answering, so does the worker, and
+        # the parent reports the crash.
+        worker_rss = rss
+        pid = fork do
+          write_frame(responses, evaluate(request, worker_rss))
+          exit!(0)
+        end
+        Process.wait(pid)
+        exit!(1) unless $?.success?
+      end
+      exit!(0)
+    rescue StandardError
+      exit!(1)
+    end
+
+    # Run one request in the template and return the marshaled reply
+    def evaluate(request, rss)
+      code, variables = request
+      reply =
+        begin
+          variables.each { |name, value| @template.set_variable(name.to_s, value) }
+          [:ok, @template.eval(code), rss]
+        rescue StandardError => e
+          [:error, e, rss]
+        end
+      Marshal.dump(reply)
+    rescue TypeError
+      # Something in the reply could not be marshaled
+      Marshal.dump([:error, Error.new("#{reply[1].class} cannot be returned from a worker"), rss])
+    end
+
+    # Workers are only stopped while idle or dead, so there is nothing to
+    # lose by killing them outright
+    def stop(worker)
+      worker.requests.close unless worker.requests.closed?
+      worker.responses.close unless worker.responses.closed?
+      Process.kill(:KILL, worker.pid)
+      Process.wait(worker.pid)
+    rescue Errno::ESRCH, Errno::ECHILD
+      nil
+    end
+
+    # data is a Marshal dump
+    def write_frame(io, data)
+      io.write([data.bytesize].pack("N"), data)
+      io.flush
+    end
+
+    # Returns nil at end of file. With a deadline (a monotonic clock value)
+    # the whole frame must arrive by then, or ReadTimeout is raised.
+    def read_frame(io, deadline = nil)
+      header = read_bytes(io, 4, deadline)
+      return nil unless header
+
+      data = read_bytes(io, header.unpack1("N"), deadline)
+      return nil unless data
+
+      # Frames only ever come from the pool's own processes
+      Marshal.load(data)
+    end
+
+    # Read exactly size bytes, or return nil if the pipe closes first
+    def read_bytes(io, size, deadline)
+      data = "".b
+      while data.bytesize < size
+        chunk = io.read_nonblock(size - data.bytesize, exception: false)
+        case chunk
+        when nil
+          return nil
+        when :wait_readable
+          if deadline
+            remaining = deadline - Process.clock_gettime(Process::CLOCK_MONOTONIC)
+            raise ReadTimeout unless remaining.positive? && io.wait_readable(remaining)
+          else
+            io.wait_readable
+          end
+        else
+          data << chunk
+        end
+      end
+      data
+    end
+
+    # Resident set size of this process in bytes, or 0 where /proc is missing
+    def rss
+      File.read("/proc/self/statm").split[1].to_i * Etc.sysconf(Etc::SC_PAGESIZE)
+    rescue SystemCallError
+      0
+    end
+  end
+end
@@ -0,0 +1,61 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestAllocationProfile < Minitest::Test
+  CHURN = <<~JS
+    function churn() {
+      var last;
+      for (var i = 0; i < 2000; i++) {
+        last = { index: i, label: "item" + i };
+      }
+      return last.index;
+    }
+    function quiet() {
+      var sum = 0;
+      for (var i = 0; i < 2000; i++) sum += i;
+      return sum;
+    }
+    quiet();
+    churn();
+  JS
+
+  def test_allocation_profile_returns_block_value
+    sandbox = MQuickJS::Sandbox.new
+    profile = sandbox.allocation_profile { |s| s.eval("1 + 2").value }
+
+    assert_instance_of MQuickJS::AllocationProfile, profile
+    assert_equal 3, profile.value
+  end
+
+  def test_allocation_profile_attributes_bytes_to_call_site
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 200_000)
+    profile = sandbox.allocation_profile(sample_bytes: 256) { |s| s.eval(CHURN) }
+
+    churn = profile.sites.select { |site, _entry| site.start_with?("churn (<eval>:") }
+    mtags = churn.values.flat_map { |entry| entry[:mtags].keys }
+
+    assert_operator churn.values.sum { |entry| entry[:bytes] }, :>=, 2000 * 16
+    assert_includes mtags, "object"
+    assert_includes mtags, "string"
+    refute(profile.sites.keys.any? { |site| site.start_with?("quiet ") })
+    assert_equal profile.total_bytes, profile.mtags.values.sum
+  end
+
+  def test_allocation_profile_stops_after_block
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 200_000)
+    sandbox.allocation_profile(sample_bytes: 64) { |s| s.eval(CHURN) }
+
+    profile = sandbox.allocation_profile { nil }
+
+    assert_equal 0, profile.samples
+  end
+
+  def test_allocation_profile_rejects_invalid_interval
+    sandbox = MQuickJS::Sandbox.new
+
+    assert_raises(ArgumentError) { sandbox.allocation_profile(sample_bytes: 0) { nil } }
+  end
+end
@@ -0,0 +1,69 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestErrorBacktrace < Minitest::Test
+  def test_timeout_error_carries_backtrace
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 50)
+
+    error = assert_raises(MQuickJS::TimeoutError) do
+      sandbox.eval(<<~JS)
+        function spin() {
+          while (true) {}
+        }
+        function outer() {
+          spin();
+        }
+        outer();
+      JS
+    end
+
+    assert_equal "JavaScript execution timeout exceeded", error.message
+    assert_match(/at spin \(<eval>:\d+:\d+\)/, error.stack)
+    assert_match(/at outer \(<eval>:5:\d+\)/, error.stack)
+  end
+
+  def test_timeout_error_backtrace_for_top_level_loop
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 50)
+
+    error = assert_raises(MQuickJS::TimeoutError) { sandbox.eval("while (true) {}") }
+
+    assert_match(/<eval>:1/, error.stack)
+  end
+
+  def test_memory_limit_error_carries_backtrace
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 20_000)
+
+    error = assert_raises(MQuickJS::MemoryLimitError) do
+      sandbox.eval(<<~JS)
+        function grow(list) {
+          for (var i = 0; i < 100000; i++) list.push({ i: i });
+        }
+        grow([]);
+      JS
+    end
+
+    assert_equal "Memory limit exceeded", error.message
+    assert_match(/at grow \(<eval>:2:\d+\)/, error.stack)
+  end
+
+  def test_memory_limit_error_keeps_console_output
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 20_000)
+
+    error = assert_raises(MQuickJS::MemoryLimitError) do
+      sandbox.eval('console.log("before"); var a = []; while (true) a.push({});')
+    end
+
+    assert_equal "before\n", error.console_output
+  end
+
+  def test_sandbox_usable_after_timeout
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 50)
+
+    assert_raises(MQuickJS::TimeoutError) { sandbox.eval("while (true) {}") }
+
+    assert_equal 3, sandbox.eval("1 + 2").value
+  end
+end
@@ -554,4 +554,20 @@ class FetchHighLevelAPITest < Minitest::Test
     assert_operator error.console_output.bytesize, :<=, 50
     assert_predicate error, :console_truncated?
   end
+
+  def test_http_error_skips_javascript_catch_and_leaves_sandbox_usable
+    sandbox = MQuickJS::Sandbox.new(
+      http: { allowlist: ["https://allowed.example.com/**"] }
+    )
+    50.times do
+      error = assert_raises(MQuickJS::HTTPBlockedError) do
+        sandbox.eval("try { fetch('https://blocked.example.com/api') } catch (e) { console.log('caught') }")
+      end
+      assert_equal "", error.console_output
+    end
+
+    # The aborted runs left no frames behind, so time slicing still works
+    assert_predicate sandbox.eval("while (true) {}", slice_ms: 1), :suspended?
+    assert sandbox.cancel
+  end
 end
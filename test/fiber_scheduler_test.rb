@@ -0,0 +1,157 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestFiberScheduler < Minitest::Test
+  # The smallest Fiber.scheduler that can run sleeping fibers side by
+  # side: timers only, and blocking I/O
+  class SleepScheduler
+    attr_reader :resolved
+
+    def initialize(addresses = ["127.0.0.1"])
+      @ready = []
+      @timers = []
+      @resolved = []
+      @addresses = addresses
+    end
+
+    def fiber(&block)
+      fiber = Fiber.new(blocking: false, &block)
+      fiber.resume
+      fiber
+    end
+
+    def kernel_sleep(duration = nil)
+      @timers << [now + duration, Fiber.current] if duration
+      Fiber.yield
+    end
+
+    def block(_blocker, timeout = nil)
+      @timers << [now + timeout, Fiber.current] if timeout
+      Fiber.yield
+    end
+
+    def unblock(_blocker, fiber)
+      @ready << fiber
+    end
+
+    def io_wait(io, events, timeout)
+      readers = events.anybits?(IO::READABLE) ? [io] : nil
+      writers = events.anybits?(IO::WRITABLE) ? [io] : nil
+      IO.select(readers, writers, nil, timeout) ? events : false
+    end
+
+    def address_resolve(hostname)
+      @resolved << hostname
+      @addresses
+    end
+
+    def close
+      until @ready.empty? && @timers.empty?
+        @ready.shift.resume until @ready.empty?
+        next if @timers.empty?
+
+        @timers.sort_by!(&:first)
+        at, fiber = @timers.shift
+        delay = at - now
+        sleep(delay) if delay.positive?
+        fiber.resume if fiber.alive?
+      end
+    end
+
+    def now
+      Process.clock_gettime(Process::CLOCK_MONOTONIC)
+    end
+  end
+
+  def sandbox_with_slow_fetch(delay)
+    sandbox = MQuickJS::Sandbox.new
+    sandbox.instance_variable_get(:@native_sandbox).http_callback = lambda do |_method, url, _body, _headers|
+      sleep delay
+      { status: 200, statusText: "OK", body: url, headers: {} }
+    end
+    sandbox
+  end
+
+  def in_scheduler(scheduler = SleepScheduler.new)
+    thread = Thread.new do
+      Fiber.set_scheduler(scheduler)
+      yield
+    end
+    thread.join
+  end
+
+  def test_fetch_waits_let_other_fibers_run_other_sandboxes
+    sandboxes = Array.new(4) { sandbox_with_slow_fetch(0.2) }
+    results = []
+    start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+
+    in_scheduler do
+      sandboxes.each_with_index do |sandbox, i|
+        Fiber.schedule { results << sandbox.eval("fetch('https://example.com/#{i}').body").value }
+      end
+    end
+    elapsed = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+
+    assert_equal((0..3).map { |i| "https://example.com/#{i}" }, results.sort)
+    # Four 200ms fetches overlapped instead of taking 800ms in turn
+    assert_operator elapsed, :<, 0.6
+  end
+
+  def test_running_sandbox_cannot_be_reentered_from_another_fiber
+    sandbox = sandbox_with_slow_fetch(0.1)
+    errors = []
+
+    in_scheduler do
+      Fiber.schedule { sandbox.eval("fetch('https://example.com').status") }
+      Fiber.schedule do
+        [-> { sandbox.eval("1") }, -> { sandbox.set_variable("x", 1) }, -> { sandbox.close }].each do |call|
+          call.call
+        rescue RuntimeError => e
+          errors << e.message
+        end
+      end
+    end
+
+    assert_equal ["Sandbox is already running JavaScript"] * 3, errors
+    refute sandbox.closed?
+    assert_equal 2, sandbox.eval("1 + 1").value
+  end
+
+  def test_callback_cannot_reenter_its_own_sandbox
+    sandbox = MQuickJS::Sandbox.new
+    sandbox.instance_variable_get(:@native_sandbox).http_callback = lambda do |*|
+      sandbox.eval("1")
+    end
+
+    error = assert_raises(RuntimeError) { sandbox.eval("fetch('https://example.com')") }
+    assert_equal "Sandbox is already running JavaScript", error.message
+    assert_equal 3, sandbox.eval("1 + 2").value
+  end
+
+  def test_dns_checks_go_through_the_scheduler
+    config = MQuickJS::HTTPConfig.new(allowlist: ["https://internal.example/**"])
+    scheduler = SleepScheduler.new
+    blocked = nil
+
+    in_scheduler(scheduler) do
+      Fiber.schedule { blocked = config.blocked_ip?("internal.example") }
+    end
+
+    assert_equal ["internal.example"], scheduler.resolved
+    assert blocked, "a name resolving to 127.0.0.1 must be blocked"
+  end
+
+  def test_any_blocked_address_blocks_the_name
+    config = MQuickJS::HTTPConfig.new(allowlist: ["https://internal.example/**"])
+    blocked = nil
+
+    in_scheduler(SleepScheduler.new(["93.184.216.34", "10.0.0.5"])) do
+      Fiber.schedule { blocked = config.blocked_ip?("internal.example") }
+    end
+
+    assert blocked, "a name with a private address among its addresses must be blocked"
+  end
+end
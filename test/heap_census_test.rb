@@ -0,0 +1,60 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestHeapCensus < Minitest::Test
+  def test_heap_census_counts_mtags_and_classes
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 200_000)
+    before = sandbox.heap_census
+    sandbox.eval("var keep = []; for (var i = 0; i < 100; i++) keep.push({ n: i, s: 'x' + i }); null")
+    census = sandbox.heap_census
+
+    assert_instance_of MQuickJS::HeapCensus, census
+    assert_equal 200_000, census.memory_limit
+    assert_operator census.heap_size, :>, before.heap_size
+    assert_operator census.classes.fetch("Object")[:count], :>=, before.classes.fetch("Object")[:count] + 100
+    assert_operator census.mtags.fetch("string")[:count], :>=, before.mtags.fetch("string", { count: 0 })[:count] + 100
+    assert_equal census.heap_size, census.mtags.values.sum { |entry| entry[:bytes] }
+    assert_equal census.mtags.values.map { |entry| entry[:bytes] }.sort.reverse,
+                 census.mtags.values.map { |entry| entry[:bytes] }
+  end
+
+  def test_heap_census_gc_drops_garbage
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 200_000)
+    sandbox.eval("var tmp = []; for (var i = 0; i < 200; i++) tmp.push({ n: i }); tmp = null;")
+
+    with_garbage = sandbox.heap_census(gc: false)
+    collected = sandbox.heap_census
+
+    assert_operator collected.heap_size, :<, with_garbage.heap_size
+    refute collected.mtags.key?("free")
+  end
+
+  def test_heap_census_without_dump
+    census = MQuickJS::Sandbox.new.heap_census
+
+    refute census.dump?
+    assert_nil census.nodes
+    assert_raises(MQuickJS::ArgumentError) { census.retained_size(0) }
+  end
+
+  def test_heap_dump_nodes_edges_and_retained_size
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 200_000)
+    sandbox.eval("var big = []; for (var i = 0; i < 200; i++) big.push('item' + i); null")
+    census = sandbox.heap_census(dump: true)
+
+    assert census.dump?
+    assert_equal census.heap_size, census.nodes.sum { |node| node[3] }
+    ids = census.nodes.to_h { |node| [node.first, true] }
+    assert(census.edges.any? { |from, _to| from.nil? })
+    assert(census.edges.all? { |from, to| (from.nil? || ids.key?(from)) && ids.key?(to) })
+
+    # The array holding the strings retains all of them
+    array_ids = census.nodes.select { |_id, _mtag, class_name, _size| class_name == "Array" }.map(&:first)
+    largest = array_ids.map { |id| census.retained_size(id) }.max
+    assert_operator largest, :>, 200 * 8
+    assert_operator largest, :<=, census.heap_size
+  end
+end
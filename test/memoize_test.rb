@@ -0,0 +1,151 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestMemoize < Minitest::Test
+  def setup
+    @sandbox = MQuickJS::Sandbox.new(memoize: 2)
+    @sandbox.eval("function price(order) { return order.qty * order.unit; }")
+  end
+
+  def test_repeated_eval_is_served_from_the_cache
+    first = @sandbox.eval("price(order)", variables: { "order" => { "qty" => 3, "unit" => 5 } })
+    second = @sandbox.eval("price(order)", variables: { "order" => { "qty" => 3, "unit" => 5 } })
+
+    assert_equal 15, second.value
+    assert_same first, second
+    assert_equal 1, @sandbox.memo_stats[:hits]
+  end
+
+  def test_different_inputs_are_different_entries
+    values = [[1, 2], [2, 2], [1, 2]].map do |qty, unit|
+      @sandbox.eval("price(order)", variables: { "order" => { "qty" => qty, "unit" => unit } }).value
+    end
+
+    assert_equal [2, 4, 2], values
+    # The setup eval and the first two inputs ran, the third was a hit
+    assert_equal({ hits: 1, misses: 3 }, @sandbox.memo_stats.slice(:hits, :misses))
+  end
+
+  def test_impure_builtins_bypass_the_cache
+    ["Date.now()", "performance.now()", "Math.random()"].each do |code|
+      2.times { @sandbox.eval(code) }
+    end
+
+    stats = @sandbox.memo_stats
+    assert_equal 0, stats[:hits]
+    # The setup eval defined a global, so it counts as impure too
+    assert_equal 7, stats[:impure]
+    assert_equal 0, stats[:size]
+  end
+
+  def test_least_recently_used_entry_is_evicted
+    sandbox = MQuickJS::Sandbox.new(memoize: 2)
+    %w[a b a c a].each { |name| sandbox.eval("'#{name}'") }
+
+    stats = sandbox.memo_stats
+    assert_equal 1, stats[:evictions]
+    assert_equal 2, stats[:hits]
+    assert_equal 2, stats[:size]
+  end
+
+  def test_cached_results_are_frozen
+    result = @sandbox.eval("({ list: [1, 2], name: 'x' })")
+
+    assert result.frozen?
+    assert result.value.frozen?
+    assert result.value["list"].frozen?
+  end
+
+  def test_errors_and_sliced_evals_are_not_cached
+    @sandbox.eval("price({ qty: 1, unit: 1 })")
+    2.times { assert_raises(MQuickJS::JavascriptError) { @sandbox.eval("throw new Error('no')") } }
+
+    assert_equal 1, @sandbox.memo_stats[:size]
+
+    # A sliced eval can change any global, so it also empties the cache
+    2.times { @sandbox.eval("1", slice_ms: 100) }
+    assert_equal 0, @sandbox.memo_stats[:size]
+  end
+
+  def test_set_variable_invalidates_the_cache
+    @sandbox.set_variable("order", { "qty" => 1, "unit" => 2 })
+    assert_equal 2, @sandbox.eval("price(order)").value
+
+    @sandbox.set_variable("order", { "qty" => 50, "unit" => 2 })
+    assert_equal 100, @sandbox.eval("price(order)").value
+    assert_equal 0, @sandbox.memo_stats[:hits]
+  end
+
+  def test_evals_writing_globals_run_every_time
+    @sandbox.eval("var n = 0")
+
+    assert_equal [1, 2], Array.new(2) { @sandbox.eval("n += 1").value }
+    assert_equal 2, @sandbox.eval("n").value
+    assert_equal [5, 6], [@sandbox.eval("n = 5").value, @sandbox.eval("n + 1").value]
+    assert_equal 0, @sandbox.memo_stats[:hits]
+  end
+
+  def test_evals_modifying_existing_objects_run_every_time
+    @sandbox.eval(<<~JS)
+      var cfg = { n: 0 }, list = [], counter = (function () { var c = 0; return function () { return ++c; }; })();
+    JS
+
+    assert_equal [1, 2], Array.new(2) { @sandbox.eval("cfg.n++; cfg.n").value }
+    assert_equal 2, @sandbox.eval("cfg.n").value
+    assert_equal [1, 2], Array.new(2) { @sandbox.eval("list.push('x')").value }
+    assert_equal [1, 2], Array.new(2) { @sandbox.eval("counter()").value }
+    assert_equal 0, @sandbox.memo_stats[:hits]
+  end
+
+  def test_evals_may_modify_objects_they_create
+    code = "(function () { var o = { list: [] }; o.list.push(price({ qty: 2, unit: 3 })); o.total = o.list[0]; return o; })()"
+    first = @sandbox.eval(code)
+    second = @sandbox.eval(code)
+
+    assert_equal({ "list" => [6], "total" => 6 }, second.value)
+    assert_same first, second
+  end
+
+  def test_writes_are_tracked_across_garbage_collections
+    sandbox = MQuickJS::Sandbox.new(memoize: 10, memory_limit: 100_000)
+    sandbox.eval("var cfg = { n: 0 }")
+    garbage = "for (var i = 0; i < 2000; i++) [i, { i: i }];"
+
+    assert_equal [1, 2], Array.new(2) { sandbox.eval("(function () { #{garbage} return ++cfg.n; })()").value }
+    pure = "(function () { #{garbage} var o = { n: cfg.n }; o.n++; return o.n; })()"
+    assert_equal [3, 3], Array.new(2) { sandbox.eval(pure).value }
+    assert_equal 1, sandbox.memo_stats[:hits]
+  end
+
+  def test_transfer_into_the_sandbox_invalidates_the_cache
+    source = MQuickJS::Sandbox.new
+    source.transfer("({ qty: 1, unit: 3 })", to: @sandbox, as: "order")
+    assert_equal 3, @sandbox.eval("price(order)").value
+
+    source.transfer("({ qty: 2, unit: 3 })", to: @sandbox, as: "order")
+    assert_equal 6, @sandbox.eval("price(order)").value
+  end
+
+  def test_variables_only_drop_entries_reading_them
+    sandbox = MQuickJS::Sandbox.new(memoize: 10)
+    sandbox.eval("function price(order) { return order.qty * order.unit; }")
+    sandbox.eval("price(order)", variables: { "order" => { "qty" => 1, "unit" => 1 } })
+    assert_equal 1, sandbox.eval("order.qty").value
+
+    # Entries setting order themselves stay, the one reading it is dropped
+    sandbox.eval("price(order)", variables: { "order" => { "qty" => 7, "unit" => 1 } })
+    assert_equal 7, sandbox.eval("order.qty").value
+    sandbox.eval("price(order)", variables: { "order" => { "qty" => 1, "unit" => 1 } })
+    assert_equal 1, sandbox.memo_stats[:hits]
+  end
+
+  def test_memoize_is_off_by_default
+    sandbox = MQuickJS::Sandbox.new
+
+    assert_nil sandbox.memo_stats
+    refute sandbox.eval("[1]").value.frozen?
+  end
+end
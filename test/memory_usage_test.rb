@@ -0,0 +1,34 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestMemoryUsage < Minitest::Test
+  def test_memory_usage_reports_heap_and_limit
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 1_000_000)
+    usage = sandbox.memory_usage
+
+    assert_equal 1_000_000, usage[:memory_limit]
+    assert_operator usage[:heap_size], :>, 0
+    assert_operator usage[:peak_heap_size], :>=, usage[:heap_size]
+  end
+
+  def test_peak_survives_garbage_collection
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 4_000_000)
+    sandbox.eval("var a = []; for (var i = 0; i < 20000; i++) a.push({ i: i }); a = null;")
+    sandbox.eval("for (var j = 0; j < 50000; j++) ({ j: j }); 1")
+    usage = sandbox.memory_usage
+
+    assert_operator usage[:peak_heap_size], :>, usage[:heap_size]
+  end
+
+  def test_reset_peak_restarts_from_current_size
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 4_000_000)
+    sandbox.eval("for (var j = 0; j < 50000; j++) ({ j: j }); 1")
+    sandbox.memory_usage(reset_peak: true)
+    usage = sandbox.memory_usage
+
+    assert_equal usage[:heap_size], usage[:peak_heap_size]
+  end
+end
@@ -0,0 +1,93 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestMetrics < Minitest::Test
+  def setup
+    MQuickJS.metrics.reset
+  end
+
+  def counters
+    MQuickJS.metrics.snapshot[:counters]
+  end
+
+  def test_reset_zeroes_counters
+    MQuickJS::Sandbox.new.eval("1")
+    MQuickJS.metrics.reset
+
+    assert_equal 0, counters[:evals]
+    assert_equal 0, MQuickJS.metrics.snapshot[:histograms][:eval_duration_seconds][:count]
+  end
+
+  def test_counts_evals_and_error_classes
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 50)
+    sandbox.eval("1 + 1")
+    assert_raises(MQuickJS::SyntaxError) { sandbox.eval("var = ;") }
+    assert_raises(MQuickJS::JavascriptError) { sandbox.eval("throw new Error('x')") }
+    assert_raises(MQuickJS::TimeoutError) { sandbox.eval("while (true) {}") }
+
+    snapshot = counters
+
+    assert_equal 4, snapshot[:evals]
+    assert_equal 1, snapshot[:syntax_errors]
+    assert_equal 1, snapshot[:javascript_errors]
+    assert_equal 1, snapshot[:timeouts]
+  end
+
+  def test_counts_memory_limit_errors
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 20_000)
+
+    assert_raises(MQuickJS::MemoryLimitError) do
+      sandbox.eval("var a = []; for (var i = 0; i < 100000; i++) a.push({ i: i });")
+    end
+
+    assert_equal 1, counters[:memory_limit_errors]
+    assert_operator counters[:gc_runs], :>, 0
+  end
+
+  def test_counts_bytes_converted_and_fetch_requests
+    sandbox = MQuickJS::Sandbox.new
+    sandbox.instance_variable_get(:@native_sandbox).http_callback = lambda do |_method, _url, _body, _headers|
+      { status: 200, body: "ok" }
+    end
+    sandbox.set_variable("s", "abcd")
+    sandbox.eval("fetch('https://example.com'); s + s")
+
+    assert_equal 1, counters[:fetch_requests]
+    assert_equal 12, counters[:bytes_converted]
+  end
+
+  def test_eval_duration_histogram_is_cumulative
+    sandbox = MQuickJS::Sandbox.new
+    3.times { sandbox.eval("1") }
+    histogram = MQuickJS.metrics.snapshot[:histograms][:eval_duration_seconds]
+
+    assert_equal 3, histogram[:count]
+    assert_equal 3, histogram[:buckets][Float::INFINITY]
+    assert_equal histogram[:buckets].values.sort, histogram[:buckets].values
+    assert_operator histogram[:sum], :>, 0
+  end
+
+  def test_aggregates_across_threads
+    threads = Array.new(4) do
+      Thread.new do
+        sandbox = MQuickJS::Sandbox.new
+        5.times { sandbox.eval("1") }
+      end
+    end
+    threads.each(&:join)
+
+    assert_equal 20, counters[:evals]
+  end
+
+  def test_to_prometheus
+    MQuickJS::Sandbox.new.eval("1")
+    text = MQuickJS.metrics.to_prometheus
+
+    assert_includes text, "mquickjs_evals_total 1\n"
+    assert_includes text, "mquickjs_eval_duration_seconds_bucket{le=\"+Inf\"} 1\n"
+    assert_includes text, "mquickjs_eval_duration_seconds_count 1\n"
+  end
+end
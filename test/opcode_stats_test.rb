@@ -0,0 +1,57 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestOpcodeStats < Minitest::Test
+  def setup
+    skip "built without MQUICKJS_OPCODE_STATS=1" unless MQuickJS::Sandbox.opcode_stats_available?
+  end
+
+  def test_opcode_stats_returns_block_value
+    sandbox = MQuickJS::Sandbox.new
+    stats = sandbox.opcode_stats { |s| s.eval("1 + 2").value }
+
+    assert_instance_of MQuickJS::OpcodeStats, stats
+    assert_equal 3, stats.value
+  end
+
+  def test_opcode_stats_counts_opcodes_and_pairs
+    sandbox = MQuickJS::Sandbox.new
+    stats = sandbox.opcode_stats do |s|
+      s.eval("var sum = 0; for (var i = 0; i < 1000; i++) { sum += i; } sum")
+    end
+
+    assert_operator stats.total, :>, 1000
+    assert_operator stats.opcodes.fetch("add"), :>=, 1000
+    assert_equal stats.opcodes.values.max, stats.opcodes.values.first
+    assert_operator stats.pairs.values.sum, :>=, stats.total - 1
+    first, second = stats.top_pairs(1).first.first
+    assert stats.opcodes.key?(first)
+    assert stats.opcodes.key?(second)
+  end
+
+  def test_opcode_stats_counts_slow_paths
+    sandbox = MQuickJS::Sandbox.new
+    fast = sandbox.opcode_stats { |s| s.eval("var n = 0; for (var i = 0; i < 100; i++) n = n + i; n") }
+    slow = sandbox.opcode_stats { |s| s.eval("var t = ''; for (var i = 0; i < 100; i++) t = t + 'x'; t.length") }
+
+    assert_equal 0, fast.slow_paths.fetch("add")
+    assert_operator slow.slow_paths.fetch("add"), :>=, 100
+    assert_operator slow.slow_path_total, :>=, 100
+  end
+
+  def test_opcode_stats_stops_after_block
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 100)
+
+    assert_raises(MQuickJS::TimeoutError) do
+      sandbox.opcode_stats { |s| s.eval("while (true) {}") }
+    end
+
+    stats = sandbox.opcode_stats { nil }
+
+    assert_equal 0, stats.total
+    assert_empty stats.pairs
+  end
+end
@@ -0,0 +1,69 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestPrelude < Minitest::Test
+  LIBRARY = (1..200).map { |i| "function helper#{i}(x) { return ['label#{i}', x * #{i}].join(':'); }" }.join("\n") + <<~JS
+    var config = { currency: 'EUR', rate: 2 };
+    function chunk(list, size) {
+      var out = [];
+      for (var i = 0; i < list.length; i += size) out.push(list.slice(i, i + size));
+      return out;
+    }
+  JS
+
+  def setup
+    @prelude = MQuickJS::Prelude.new(LIBRARY, filename: "helpers.js")
+  end
+
+  def test_functions_are_available_in_every_sandbox
+    sandboxes = Array.new(3) { MQuickJS::Sandbox.new(prelude: @prelude) }
+
+    sandboxes.each do |sandbox|
+      assert_equal [[1, 2], [3]], sandbox.eval("chunk([1, 2, 3], 2)").value
+      assert_equal "label200:400", sandbox.eval("helper200(2)").value
+    end
+  end
+
+  def test_globals_are_private_to_each_sandbox
+    first = MQuickJS::Sandbox.new(prelude: @prelude)
+    second = MQuickJS::Sandbox.new(prelude: @prelude)
+    first.eval("config.rate = 5; chunk = null")
+
+    assert_equal 2, second.eval("config.rate").value
+    assert_equal "function", second.eval("typeof chunk").value
+  end
+
+  def test_attached_prelude_uses_less_heap_than_evaluating_it
+    attached = MQuickJS::Sandbox.new(memory_limit: 500_000, prelude: @prelude)
+    evaluated = MQuickJS::Sandbox.new(memory_limit: 500_000)
+    evaluated.eval(LIBRARY)
+
+    assert_operator attached.memory_usage[:heap_size], :<, evaluated.memory_usage[:heap_size] / 2
+    assert_operator @prelude.bytesize, :>, 0
+  end
+
+  def test_image_outlives_the_prelude_object
+    sandbox = MQuickJS::Sandbox.new(prelude: MQuickJS::Prelude.new("function twice(x) { return x * 2; }"))
+    GC.start
+    sandbox.heap_census(gc: true)
+
+    assert_equal 42, sandbox.eval("twice(21)").value
+  end
+
+  def test_errors_are_raised_when_compiling_and_attaching
+    assert_raises(MQuickJS::SyntaxError) { MQuickJS::Prelude.new("function (") }
+    assert_raises(MQuickJS::MemoryLimitError) { MQuickJS::Prelude.new(LIBRARY, memory_limit: 20_000) }
+    prelude = MQuickJS::Prelude.new("throw new Error('broken helper')")
+    error = assert_raises(MQuickJS::JavascriptError) { MQuickJS::Sandbox.new(prelude: prelude) }
+    assert_includes error.message, "broken helper"
+    assert_raises(MQuickJS::ArgumentError) { MQuickJS::Sandbox.new(prelude: LIBRARY) }
+  end
+
+  def test_prelude_is_shareable_between_ractors
+    assert @prelude.frozen?
+    assert Ractor.shareable?(@prelude)
+  end
+end
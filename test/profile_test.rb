@@ -0,0 +1,92 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestProfile < Minitest::Test
+  HOT_LOOP = <<~JS
+    function hot() {
+      var sum = 0;
+      for (var i = 0; i < 2000000; i++) {
+        sum += i % 7;
+      }
+      return sum;
+    }
+    function outer() {
+      return hot();
+    }
+    outer();
+  JS
+
+  def test_profile_returns_block_value
+    sandbox = MQuickJS::Sandbox.new
+    profile = sandbox.profile { |s| s.eval("1 + 2").value }
+
+    assert_instance_of MQuickJS::Profile, profile
+    assert_equal 3, profile.value
+  end
+
+  def test_profile_records_collapsed_stacks
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 30_000)
+    profile = sandbox.profile(interval_us: 200) { |s| s.eval(HOT_LOOP) }
+
+    assert_operator profile.samples, :>, 0
+    profile.collapsed_stacks.each_line do |line|
+      assert_match(/\A\S.* \d+\n\z/, line)
+    end
+    assert_match(/outer \(<eval>:9\);hot \(<eval>:\d+\) \d+/, profile.collapsed_stacks)
+  end
+
+  def test_profile_function_self_and_total
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 30_000)
+    profile = sandbox.profile(interval_us: 200) { |s| s.eval(HOT_LOOP) }
+
+    hot = profile.functions.fetch("hot (<eval>)")
+    outer = profile.functions.fetch("outer (<eval>)")
+
+    assert_operator hot[:self], :>, 0
+    assert_equal 0, outer[:self]
+    assert_operator outer[:total], :>=, hot[:total]
+  end
+
+  def test_profile_counts_recursion_once_in_total
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 200_000, timeout_ms: 30_000)
+    profile = sandbox.profile(interval_us: 200) do |s|
+      s.eval("function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); } fib(24)")
+    end
+
+    fib = profile.functions.fetch("fib (<eval>)")
+
+    assert_operator fib[:total], :<=, profile.samples
+  end
+
+  def test_profile_stops_after_block
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 30_000)
+    sandbox.profile { |s| s.eval("1") }
+
+    # A second profile must start from an empty sample set
+    profile = sandbox.profile { |s| s.eval("2") }
+
+    assert_equal 0, profile.samples
+    assert_equal 2, sandbox.eval("2").value
+  end
+
+  def test_profile_stops_when_block_raises
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 100)
+
+    assert_raises(MQuickJS::TimeoutError) do
+      sandbox.profile { |s| s.eval("while (true) {}") }
+    end
+
+    profile = sandbox.profile { |s| s.eval("1") }
+
+    assert_equal 1, profile.value.value
+  end
+
+  def test_profile_rejects_invalid_interval
+    sandbox = MQuickJS::Sandbox.new
+
+    assert_raises(ArgumentError) { sandbox.profile(interval_us: 0) { nil } }
+  end
+end
@@ -0,0 +1,56 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestRactor < Minitest::Test
+  def setup
+    skip "Ractor is not available" unless defined?(Ractor)
+    Warning[:experimental] = false
+  end
+
+  def test_eval_in_ractor
+    ractor = Ractor.new do
+      result = MQuickJS::Sandbox.new.eval("console.log('hi'); [1, { a: 2 }]")
+      [result.value, result.console_output]
+    end
+
+    assert_equal [[1, { "a" => 2 }], "hi\n"], ractor.take
+  end
+
+  def test_errors_in_ractor
+    ractor = Ractor.new do
+      sandbox = MQuickJS::Sandbox.new(timeout_ms: 50)
+      [
+        (begin; sandbox.eval("throw new TypeError('bad')"); rescue MQuickJS::JavascriptError => e; e.message; end),
+        (begin; sandbox.eval("while (true) {}"); rescue MQuickJS::TimeoutError => e; e.class.name; end)
+      ]
+    end
+
+    assert_equal ["TypeError: bad", "MQuickJS::TimeoutError"], ractor.take
+  end
+
+  def test_parallel_ractors
+    ractors = Array.new(4) do |i|
+      Ractor.new(i) do |n|
+        sandbox = MQuickJS::Sandbox.new
+        sandbox.set_variable("n", n)
+        sandbox.eval("var s = 0; for (var i = 0; i < 10000; i++) s += n; s").value
+      end
+    end
+
+    assert_equal [0, 10_000, 20_000, 30_000], ractors.map(&:take)
+  end
+
+  def test_http_checks_in_ractor
+    ractor = Ractor.new do
+      sandbox = MQuickJS::Sandbox.new(http: { allowlist: ["http://127.0.0.1/**"] })
+      sandbox.eval("fetch('http://127.0.0.1/')")
+    rescue MQuickJS::HTTPBlockedError => e
+      e.message
+    end
+
+    assert_match(/blocked IP/, ractor.take)
+  end
+end
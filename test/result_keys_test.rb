@@ -0,0 +1,74 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestResultKeys < Minitest::Test
+  def test_keys_are_shared_frozen_strings
+    rows = MQuickJS::Sandbox.new.eval("[{ id: 1, name: 'a' }, { id: 2, name: 'b' }]").value
+
+    assert_equal [{ "id" => 1, "name" => "a" }, { "id" => 2, "name" => "b" }], rows
+    first, second = rows.map(&:keys)
+    assert(first.all?(&:frozen?))
+    assert_same first[0], second[0]
+    assert_equal Encoding::UTF_8, first[1].encoding
+  end
+
+  def test_symbolize_keys
+    sandbox = MQuickJS::Sandbox.new(symbolize_keys: true)
+
+    assert_equal({ id: 1, nested: { list: [{ "é": true }] }, "1": "one" },
+                 sandbox.eval("({ id: 1, nested: { list: [{ 'é': true }] }, 1: 'one' })").value)
+  end
+
+  def test_large_tabular_result
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 2_000_000)
+    rows = sandbox.eval(<<~JS).value
+      var rows = [];
+      for (var i = 0; i < 5000; i++) rows.push({ id: i, name: 'row' + i, tags: ['a', 'b'], meta: { n: i / 2 } });
+      rows
+    JS
+
+    assert_equal 5000, rows.size
+    assert_equal({ "id" => 4999, "name" => "row4999", "tags" => %w[a b], "meta" => { "n" => 2499.5 } }, rows.last)
+  end
+
+  def test_getters_and_allocating_values_inside_records
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 500_000)
+    rows = sandbox.eval(<<~JS).value
+      var rows = [];
+      for (var i = 0; i < 200; i++) {
+        rows.push({ id: i, error: new Error('e' + i),
+                    get total() { var garbage = []; for (var k = 0; k < 50; k++) garbage.push({ k: k }); return 7; },
+                    last: 'x' + i });
+      }
+      rows
+    JS
+
+    assert_equal({ "id" => 199, "error" => "Error: e199", "total" => 7, "last" => "x199" }, rows.last)
+  end
+
+  def test_cyclic_values_raise
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 500_000)
+
+    error = assert_raises(MQuickJS::JavascriptError) { sandbox.eval("var a = {}; a.self = a; a") }
+    assert_equal "RangeError: value too deeply nested to convert", error.message
+
+    cyclic = []
+    cyclic << cyclic
+    error = assert_raises(ArgumentError) { sandbox.set_variable("cyclic", cyclic) }
+    assert_equal "Value too deeply nested to convert", error.message
+    assert_equal 2, sandbox.eval("1 + 1").value
+  end
+
+  def test_repeated_large_set_variable
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 200_000)
+    rows = Array.new(200) { |i| { "id" => i, "name" => "row#{i}", "tags" => %w[a b c], "meta" => { "n" => i.to_f } } }
+
+    20.times do
+      sandbox.set_variable("rows", rows)
+      assert_equal [200, "row199", 199.0], sandbox.eval("[rows.length, rows[199].name, rows[199].meta.n]").value
+    end
+  end
+end
@@ -0,0 +1,97 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestResume < Minitest::Test
+  LONG_SCRIPT = <<~JS
+    function work(n) { var t = 0; for (var i = 0; i < n; i++) { t += i % 7; } return t; }
+    var total = 0;
+    for (var k = 0; k < 20; k++) { total += work(100000); console.log("round " + k); }
+    total
+  JS
+
+  def test_suspended_eval_resumes_to_the_same_result
+    expected = MQuickJS::Sandbox.new(timeout_ms: 20_000).eval(LONG_SCRIPT)
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 20_000)
+
+    result = sandbox.eval(LONG_SCRIPT, slice_ms: 1)
+    assert result.suspended?
+    assert_nil result.value
+    assert sandbox.suspended?
+
+    result = sandbox.resume(slice_ms: 1) while result.suspended?
+    refute sandbox.suspended?
+    assert_equal expected.value, result.value
+    assert_equal expected.console_output, result.console_output
+  end
+
+  def test_short_script_finishes_within_its_slice
+    sandbox = MQuickJS::Sandbox.new
+    result = sandbox.eval("1 + 1", slice_ms: 1000)
+
+    refute result.suspended?
+    assert_equal 2, result.value
+  end
+
+  def test_eval_raises_while_suspended
+    sandbox = MQuickJS::Sandbox.new
+    assert sandbox.eval("var n = 0; while (true) n++", slice_ms: 1).suspended?
+
+    assert_raises(RuntimeError) { sandbox.eval("1") }
+    assert sandbox.suspended?
+  end
+
+  def test_cancel_unwinds_the_suspended_eval
+    sandbox = MQuickJS::Sandbox.new
+    sandbox.eval("var n = 0; try { while (true) n++ } catch (e) { n = -1 }", slice_ms: 1)
+
+    assert sandbox.cancel
+    refute sandbox.suspended?
+    refute sandbox.cancel
+    # The abort is uncatchable, so the catch block never ran
+    assert sandbox.eval("n > 0").value
+    assert_raises(RuntimeError) { sandbox.resume }
+  end
+
+  def test_timeout_counts_running_time_only
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 200)
+    result = sandbox.eval("var t = Date.now(); while (Date.now() - t < 150) {}; 'done'", slice_ms: 20)
+    while result.suspended?
+      sleep 0.05
+      result = sandbox.resume(slice_ms: 20)
+    end
+    assert_equal "done", result.value
+
+    sandbox.eval("while (true) {}", slice_ms: 20)
+    assert_raises(MQuickJS::TimeoutError) do
+      sandbox.resume(slice_ms: 20) while sandbox.suspended?
+    end
+    refute sandbox.suspended?
+  end
+
+  def test_heap_survives_garbage_collection_while_suspended
+    sandbox = MQuickJS::Sandbox.new(memory_limit: 1_000_000)
+    code = <<~JS
+      function make(i) { var box = { v: i }; return function () { return box.v; }; }
+      var fns = [], sum = 0;
+      for (var i = 0; i < 20000; i++) { fns.push(make(i)); if (fns.length > 50) fns.shift(); sum += fns[fns.length - 1](); }
+      sum
+    JS
+
+    result = sandbox.eval(code, slice_ms: 1)
+    while result.suspended?
+      sandbox.heap_census(gc: true)
+      sandbox.set_variable("extra", { "list" => [1, 2, "x" * 100] })
+      result = sandbox.resume(slice_ms: 1)
+    end
+    assert_equal((0...20_000).sum, result.value)
+  end
+
+  def test_slice_ms_must_be_positive
+    sandbox = MQuickJS::Sandbox.new
+
+    assert_raises(ArgumentError) { sandbox.eval("1", slice_ms: 0) }
+  end
+end
@@ -0,0 +1,41 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestSandboxClose < Minitest::Test
+  def test_close_frees_the_sandbox
+    sandbox = MQuickJS::Sandbox.new
+    sandbox.eval("var x = 1")
+
+    refute sandbox.closed?
+    assert_nil sandbox.close
+    assert sandbox.closed?
+  end
+
+  def test_calls_after_close_raise
+    sandbox = MQuickJS::Sandbox.new
+    sandbox.close
+
+    assert_raises(RuntimeError) { sandbox.eval("1") }
+    assert_raises(RuntimeError) { sandbox.set_variable("x", 1) }
+    assert_raises(RuntimeError) { sandbox.memory_usage }
+  end
+
+  def test_close_is_idempotent
+    sandbox = MQuickJS::Sandbox.new
+    sandbox.close
+    sandbox.close
+
+    assert sandbox.closed?
+  end
+
+  def test_creation_timings
+    timings = MQuickJS::Sandbox.new(memory_limit: 1_000_000).creation_timings
+
+    assert_equal %i[arena_alloc_ms new_context_ms], timings.keys.sort
+    assert_operator timings[:arena_alloc_ms], :>=, 0
+    assert_operator timings[:new_context_ms], :>, 0
+  end
+end
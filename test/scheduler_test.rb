@@ -0,0 +1,109 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestScheduler < Minitest::Test
+  # About 100ms of CPU, in many loop iterations so it can be time-sliced
+  BUSY_SCRIPT = "var t = 0; for (var i = 0; i < 3000000; i++) { t += i % 3; } t"
+
+  def setup
+    @scheduler = MQuickJS::Scheduler.new(threads: 1, quantum_ms: 2, sandbox_options: { timeout_ms: 60_000 })
+  end
+
+  def teardown
+    @scheduler.shutdown unless @scheduler.closed?
+  end
+
+  def test_runs_jobs_to_completion
+    jobs = Array.new(3) { |i| @scheduler.submit("#{i} * 10", tenant: "a") }
+
+    assert_equal [0, 10, 20], jobs.map { |job| job.value.value }
+    stats = @scheduler.stats["a"]
+    assert_equal 3, stats[:submitted]
+    assert_equal 3, stats[:completed]
+    assert_equal 0, stats[:queued]
+  end
+
+  def test_errors_are_raised_from_value
+    job = @scheduler.submit("throw new Error('boom')", tenant: "a")
+
+    assert_raises(MQuickJS::JavascriptError) { job.value }
+    assert_equal 1, @scheduler.stats["a"][:failed]
+  end
+
+  def test_weighted_tenants_share_cpu_by_weight
+    @scheduler.tenant("heavy", weight: 3)
+    @scheduler.tenant("light", weight: 1)
+    heavy = @scheduler.submit(BUSY_SCRIPT, tenant: "heavy")
+    light = @scheduler.submit(BUSY_SCRIPT, tenant: "light")
+
+    heavy.value
+    light_quanta = light.quanta
+    light.value
+
+    # While both had work, light ran about a third as many quanta
+    assert_operator light_quanta, :<, heavy.quanta * 0.6
+    assert_operator light_quanta, :>, 0
+  end
+
+  def test_cpu_budget_throttles_a_tenant
+    scheduler = MQuickJS::Scheduler.new(quantum_ms: 2, budget_period_ms: 100)
+    scheduler.tenant("limited", cpu_budget_ms: 10)
+    start = MQuickJS::Scheduler.now
+    job = scheduler.submit(BUSY_SCRIPT, tenant: "limited")
+    job.value
+    elapsed_ms = (MQuickJS::Scheduler.now - start) * 1000
+
+    stats = scheduler.stats["limited"]
+    assert_operator stats[:throttled], :>, 0
+    # 10ms of CPU per 100ms, so the job takes several times its CPU time
+    assert_operator elapsed_ms, :>, job.cpu_ms * 3
+  ensure
+    scheduler&.shutdown
+  end
+
+  def test_jobs_run_earliest_deadline_first
+    finished = []
+    lazy = @scheduler.submit(BUSY_SCRIPT, tenant: "a")
+    urgent = @scheduler.submit("'urgent'", tenant: "a", deadline_ms: 5000)
+    [Thread.new { lazy.value && finished << :lazy }, Thread.new { urgent.value && finished << :urgent }].each(&:join)
+
+    assert_equal %i[urgent lazy], finished
+  end
+
+  def test_missed_deadline_cancels_the_job
+    job = @scheduler.submit("while (true) {}", tenant: "a", deadline_ms: 30)
+
+    assert_raises(MQuickJS::DeadlineExceededError) { job.value }
+    assert_equal 1, @scheduler.stats["a"][:expired]
+  end
+
+  def test_expired_job_does_not_release_a_shared_sandbox
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 60_000)
+    first = @scheduler.submit(BUSY_SCRIPT, tenant: "a", sandbox: sandbox)
+    sleep 0.001 until first.quanta.positive?
+    expiring = @scheduler.submit("'late'", tenant: "a", sandbox: sandbox, deadline_ms: 30)
+    last = @scheduler.submit("'last'", tenant: "a", sandbox: sandbox)
+
+    assert_raises(MQuickJS::DeadlineExceededError) { expiring.value }
+    # The queued job waited for the suspended one instead of running over it
+    assert_equal 3_000_000, first.value.value
+    assert_equal "last", last.value.value
+  end
+
+  def test_stats_report_cpu_and_queue_delay
+    jobs = Array.new(2) { |i| @scheduler.submit(BUSY_SCRIPT, tenant: "t#{i}") }
+    jobs.each(&:value)
+
+    stats = @scheduler.stats
+    %w[t0 t1].each do |tenant|
+      assert_operator stats[tenant][:cpu_ms], :>, 0
+      assert_operator stats[tenant][:quanta], :>, 1
+      assert_operator stats[tenant][:max_queue_delay_ms], :>=, stats[tenant][:mean_queue_delay_ms]
+    end
+    # With one thread, each tenant waited while the other ran
+    assert_operator stats["t1"][:queue_delay_ms], :>, 0
+  end
+end
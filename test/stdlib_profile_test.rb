@@ -0,0 +1,58 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestStdlibProfile < Minitest::Test
+  def test_profiles_are_listed
+    assert_equal %i[full minimal], MQuickJS.stdlib_profiles.first(2)
+  end
+
+  def test_minimal_profile_leaves_out_unlisted_globals
+    sandbox = MQuickJS::Sandbox.new(stdlib: :minimal)
+
+    %w[Date Uint8Array fetch performance].each do |name|
+      assert_equal "undefined", sandbox.eval("typeof #{name}").value, name
+    end
+    assert_equal "function", MQuickJS::Sandbox.new.eval("typeof Date").value
+  end
+
+  def test_minimal_profile_keeps_the_core_language
+    sandbox = MQuickJS::Sandbox.new(stdlib: :minimal)
+
+    assert_equal({ "max" => 3, "parts" => %w[a b] },
+                 sandbox.eval("JSON.parse(JSON.stringify({ max: Math.max(1, 3), parts: 'a,b'.split(',') }))").value)
+    assert sandbox.eval("try { missing } catch (e) { e instanceof ReferenceError }").value
+    assert_equal "hi\n", sandbox.eval("console.log('hi')").console_output
+  end
+
+  def test_minimal_profile_keeps_regexp_literals_working
+    sandbox = MQuickJS::Sandbox.new(stdlib: :minimal)
+
+    assert_equal [true, "a+", ["aa"], "axc", %w[a b]],
+                 sandbox.eval("[/a/ instanceof RegExp, /a+/g.source, /a+/.exec('baa'), 'abc'.replace(/b/, 'x'), 'a,b'.split(/,/)]").value
+    assert_equal "b", sandbox.eval("new RegExp('b').exec('abc')[0]").value
+  end
+
+  def test_minimal_profile_uses_a_smaller_heap
+    full = MQuickJS::Sandbox.new.memory_usage[:heap_size]
+    minimal = MQuickJS::Sandbox.new(stdlib: :minimal).memory_usage[:heap_size]
+
+    assert_operator minimal, :<, full
+  end
+
+  def test_prelude_is_bound_to_its_profile
+    prelude = MQuickJS::Prelude.new("function square(x) { return x * x; }", stdlib: :minimal)
+
+    assert_equal :minimal, prelude.stdlib
+    assert_equal 16, MQuickJS::Sandbox.new(stdlib: :minimal, prelude: prelude).eval("square(4)").value
+    error = assert_raises(ArgumentError) { MQuickJS::Sandbox.new(prelude: prelude) }
+    assert_match(/compiled for the 'minimal' stdlib/, error.message)
+  end
+
+  def test_unknown_profile_raises
+    error = assert_raises(ArgumentError) { MQuickJS::Sandbox.new(stdlib: :tiny) }
+    assert_equal "Unknown stdlib profile 'tiny'", error.message
+  end
+end
@@ -0,0 +1,60 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestTimings < Minitest::Test
+  KEYS = %i[parse_ms run_ms convert_ms gc_ms gc_count gc_max_ms host_ms host_calls total_ms].freeze
+
+  def test_timings_disabled_by_default
+    result = MQuickJS::Sandbox.new.eval("1 + 1")
+
+    assert_nil result.timings
+  end
+
+  def test_timings_breakdown
+    sandbox = MQuickJS::Sandbox.new(timings: true)
+    result = sandbox.eval("var a = []; for (var i = 0; i < 1000; i++) a.push(i); a")
+    timings = result.timings
+
+    assert_equal KEYS.sort, timings.keys.sort
+    assert_operator timings[:parse_ms], :>, 0
+    assert_operator timings[:run_ms], :>, 0
+    assert_operator timings[:convert_ms], :>, 0
+    assert_in_delta timings[:parse_ms] + timings[:run_ms] + timings[:convert_ms], timings[:total_ms], 1e-6
+  end
+
+  def test_timings_count_gc
+    sandbox = MQuickJS::Sandbox.new(timings: true)
+    result = sandbox.eval("gc(); gc(); 1")
+
+    assert_operator result.timings[:gc_count], :>=, 2
+    assert_operator result.timings[:gc_ms], :<=, result.timings[:run_ms]
+    assert_operator result.timings[:gc_max_ms], :>, 0
+    assert_operator result.timings[:gc_max_ms], :<=, result.timings[:gc_ms]
+  end
+
+  def test_timings_count_host_callbacks
+    sandbox = MQuickJS::Sandbox.new(timings: true)
+    sandbox.instance_variable_get(:@native_sandbox).http_callback = lambda do |_method, _url, _body, _headers|
+      sleep 0.01
+      { status: 200, body: "ok" }
+    end
+
+    result = sandbox.eval("console.log('a'); console.log('b'); fetch('https://example.com').body")
+
+    assert_equal "ok", result.value
+    assert_equal 3, result.timings[:host_calls]
+    assert_operator result.timings[:host_ms], :>=, 10
+  end
+
+  def test_timings_reset_between_evals
+    sandbox = MQuickJS::Sandbox.new(timings: true)
+    sandbox.eval("gc(); console.log('x')")
+    result = sandbox.eval("1")
+
+    assert_equal 0, result.timings[:gc_count]
+    assert_equal 0, result.timings[:host_calls]
+  end
+end
@@ -0,0 +1,54 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+
+class TestTransfer < Minitest::Test
+  def setup
+    @source = MQuickJS::Sandbox.new(memory_limit: 500_000)
+    @target = MQuickJS::Sandbox.new(memory_limit: 500_000)
+  end
+
+  def test_copies_the_value_into_a_global
+    @source.eval("var order = { id: 7, total: 12.5, items: ['a', 'b'], paid: true, note: null }")
+    @source.transfer("order", to: @target, as: "order")
+
+    assert_equal({ "id" => 7, "total" => 12.5, "items" => %w[a b], "paid" => true, "note" => nil },
+                 @target.eval("order").value)
+    # A copy, not a shared object
+    @target.eval("order.items.push('c')")
+    assert_equal 2, @source.eval("order.items.length").value
+  end
+
+  def test_keeps_cycles_and_shared_references
+    @source.eval("var tag = { name: 'x' }; var doc = { a: tag, b: [tag] }; doc.self = doc; null")
+    @source.transfer("doc", to: @target, as: :doc)
+
+    assert_equal [true, true], @target.eval("[doc.self === doc, doc.a === doc.b[0]]").value
+  end
+
+  def test_functions_cannot_be_transferred
+    error = assert_raises(MQuickJS::JavascriptError) do
+      @source.transfer("({ run: function () {} })", to: @target, as: "job")
+    end
+    assert_equal "TypeError: cannot clone a function", error.message
+    assert_equal "undefined", @target.eval("typeof job").value
+  end
+
+  def test_copy_counts_against_the_target_memory_limit
+    @source.eval("var rows = []; for (var i = 0; i < 2000; i++) rows.push({ id: i, label: 'row ' + i });")
+    small = MQuickJS::Sandbox.new(memory_limit: 20_000)
+
+    assert_raises(MQuickJS::MemoryLimitError) { @source.transfer("rows", to: small, as: "rows") }
+    assert_equal 2, small.eval("1 + 1").value
+    @source.transfer("rows", to: @target, as: "rows")
+    assert_equal "row 1999", @target.eval("rows[1999].label").value
+  end
+
+  def test_errors_in_the_expression_are_raised
+    assert_raises(MQuickJS::JavascriptError) { @source.transfer("missing", to: @target, as: "x") }
+    assert_raises(ArgumentError) { @source.transfer("1", to: @source, as: "x") }
+    assert_raises(MQuickJS::ArgumentError) { @source.transfer("1", to: nil, as: "x") }
+  end
+end
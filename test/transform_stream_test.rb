@@ -0,0 +1,108 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+require "stringio"
+
+class TestTransformStream < Minitest::Test
+  INPUT = <<~NDJSON
+    {"id": 1, "total": 2.5, "name": "ä"}
+
+    {"id": 2, "total": 0}
+    not json
+    {"id": 3, "total": -1}
+    {"id": 4, "total": 7, "name": "z"}
+  NDJSON
+
+  def setup
+    @sandbox = MQuickJS::Sandbox.new
+    @sandbox.eval(<<~JS)
+      function enrich(r) {
+        if (r.total === 0) return undefined;
+        if (r.total < 0) throw new RangeError('negative total in ' + r.id);
+        return { id: r.id, cents: r.total * 100, name: r.name };
+      }
+    JS
+    @output = StringIO.new
+  end
+
+  def test_writes_one_line_per_result
+    stats = @sandbox.transform_stream("enrich", StringIO.new(INPUT), @output, errors: :skip)
+
+    assert_equal [{ "id" => 1, "cents" => 250, "name" => "ä" }, { "id" => 4, "cents" => 700, "name" => "z" }],
+                 @output.string.lines.map { |line| JSON.parse(line) }
+    assert_equal({ lines: 6, records: 5, written: 2, errors: 2, bytes_read: INPUT.bytesize,
+                   bytes_written: @output.string.bytesize }, stats)
+  end
+
+  def test_records_split_across_chunks_are_reassembled
+    stats = @sandbox.transform_stream("enrich", StringIO.new(INPUT), @output, errors: :skip, chunk_size: 5)
+
+    assert_equal 2, stats[:written]
+    assert_equal 2, @output.string.lines.size
+  end
+
+  def test_error_records_name_the_line
+    errors = StringIO.new
+    @sandbox.transform_stream("enrich", StringIO.new(INPUT), @output, errors: errors)
+
+    assert_equal [{ "line" => 4, "error" => "SyntaxError: unexpected character" },
+                  { "line" => 5, "error" => "RangeError: negative total in 3" }],
+                 errors.string.lines.map { |line| JSON.parse(line) }
+  end
+
+  def test_nul_byte_does_not_split_a_record
+    errors = StringIO.new
+    input = "{\"id\": 1, \"total\": 1}\n{\"id\": 2}\u0000{\"id\": 9}\n{\"id\": 3, \"total\": -1}\n"
+    stats = @sandbox.transform_stream("enrich", StringIO.new(input), @output, errors: errors)
+
+    assert_equal 3, stats[:records]
+    assert_equal [2, 3], errors.string.lines.map { |line| JSON.parse(line)["line"] }
+  end
+
+  def test_first_error_is_raised_by_default
+    error = assert_raises(MQuickJS::JavascriptError) do
+      @sandbox.transform_stream("enrich", StringIO.new(INPUT), @output)
+    end
+
+    assert_equal "line 4: SyntaxError: unexpected character", error.message
+    assert_equal 1, @output.string.lines.size
+  end
+
+  def test_timeout_applies_to_each_record
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 50)
+    sandbox.eval("function spin(r) { while (r.forever) {} return r; }")
+
+    assert_raises(MQuickJS::TimeoutError) do
+      sandbox.transform_stream("spin", StringIO.new("{}\n{\"forever\": true}\n"), @output)
+    end
+    assert_equal "{}\n", @output.string
+    assert_equal 2, sandbox.eval("1 + 1").value
+  end
+
+  def test_each_record_counts_as_one_eval_in_metrics
+    MQuickJS.metrics.reset
+    @sandbox.transform_stream("enrich", StringIO.new(INPUT), @output, errors: :skip)
+    snapshot = MQuickJS.metrics.snapshot
+
+    assert_equal({ evals: 5, syntax_errors: 1, javascript_errors: 1, timeouts: 0 },
+                 snapshot[:counters].slice(:evals, :syntax_errors, :javascript_errors, :timeouts))
+    assert_equal 5, snapshot[:histograms][:eval_duration_seconds][:count]
+
+    sandbox = MQuickJS::Sandbox.new(timeout_ms: 50)
+    sandbox.eval("function spin(r) { while (r.forever) {} return r; }")
+    MQuickJS.metrics.reset
+    assert_raises(MQuickJS::TimeoutError) do
+      sandbox.transform_stream("spin", StringIO.new("{}\n{\"forever\": true}\n{}\n"), @output)
+    end
+    assert_equal({ evals: 2, timeouts: 1 }, MQuickJS.metrics.snapshot[:counters].slice(:evals, :timeouts))
+  end
+
+  def test_function_must_exist
+    assert_raises(ArgumentError) { @sandbox.transform_stream("missing", StringIO.new("{}\n"), @output) }
+    assert_raises(MQuickJS::ArgumentError) do
+      @sandbox.transform_stream("enrich", StringIO.new("{}\n"), @output, errors: :ignore)
+    end
+  end
+end
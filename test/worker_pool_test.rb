@@ -0,0 +1,116 @@
+#!/usr/bin/env ruby
+# frozen_string_literal: true
+
+require "mquickjs"
+require "minitest/autorun"
+require "timeout"
+
+class TestWorkerPool < Minitest::Test
+  def setup
+    skip "fork is not available" unless Process.respond_to?(:fork)
+  end
+
+  def teardown
+    @pool&.shutdown unless @pool&.closed?
+  end
+
+  def test_eval_uses_the_prelude_and_variables
+    @pool = MQuickJS::WorkerPool.new(size: 2, prelude: "function double(x) { return x * 2; }")
+
+    result = @pool.eval("console.log('hi'); double(input)", variables: { input: 21 })
+
+    assert_equal 42, result.value
+    assert_equal "hi\n", result.console_output
+  end
+
+  def test_errors_are_raised_in_the_caller
+    @pool = MQuickJS::WorkerPool.new(size: 1, sandbox: { timeout_ms: 50 })
+
+    error = assert_raises(MQuickJS::JavascriptError) { @pool.eval("throw new Error('boom')") }
+    assert_equal "Error: boom", error.message
+    assert_raises(MQuickJS::TimeoutError) { @pool.eval("while (true) {}") }
+    assert_equal 2, @pool.eval("1 + 1").value
+  end
+
+  def test_concurrent_callers
+    @pool = MQuickJS::WorkerPool.new(size: 2, max_queue: 10)
+
+    values = Array.new(8) { |i| Thread.new { @pool.eval("#{i} * 3").value } }.map(&:value)
+
+    assert_equal (0...8).map { |i| i * 3 }, values
+  end
+
+  def test_crashed_worker_is_replaced
+    @pool = MQuickJS::WorkerPool.new(size: 1)
+    Process.kill(:KILL, @pool.instance_variable_get(:@workers).first.pid)
+
+    assert_raises(MQuickJS::WorkerCrashedError) { @pool.eval("1") }
+    assert_equal 1, @pool.eval("1").value
+    assert_equal 1, @pool.stats[:crashes]
+  end
+
+  def test_unmarshalable_variables_do_not_take_a_worker
+    @pool = MQuickJS::WorkerPool.new(size: 1)
+
+    assert_raises(TypeError) { @pool.eval("1", variables: { "x" => proc {} }) }
+    assert_equal 0, @pool.stats[:busy]
+    assert_equal 2, @pool.eval("1 + 1").value
+  end
+
+  def test_interrupted_eval_replaces_the_worker
+    @pool = MQuickJS::WorkerPool.new(size: 1)
+
+    assert_raises(Timeout::Error) do
+      Timeout.timeout(0.05) { @pool.eval("var t = Date.now(); while (Date.now() - t < 300) {} 'late'") }
+    end
+    assert_equal 0, @pool.stats[:busy]
+    assert_equal "next", @pool.eval("'next'").value
+    assert_equal 1, @pool.stats[:recycled]
+  end
+
+  def test_reply_timeout_covers_the_whole_frame
+    @pool = MQuickJS::WorkerPool.new(size: 1, reply_timeout: 0.2)
+    worker = @pool.instance_variable_get(:@workers).first
+    # A worker that stops after writing the first bytes of a frame
+    Process.kill(:STOP, worker.pid)
+    reader, writer = IO.pipe
+    writer.write([100].pack("N"), "x")
+    worker.responses.close
+    worker.responses = reader
+
+    error = assert_raises(MQuickJS::WorkerCrashedError) { @pool.eval("1") }
+    assert_match(/did not answer within 0.2s/, error.message)
+    assert_equal 1, @pool.eval("1").value
+  ensure
+    writer&.close
+  end
+
+  def test_workers_are_recycled_after_max_evals
+    @pool = MQuickJS::WorkerPool.new(size: 1, max_evals: 2)
+
+    @pool.eval("var counter = 1")
+    assert_equal 1, @pool.eval("counter").value
+    assert_equal "undefined", @pool.eval("typeof counter").value
+    assert_equal 1, @pool.stats[:recycled]
+  end
+
+  def test_isolated_evals_start_from_the_template
+    @pool = MQuickJS::WorkerPool.new(size: 1, prelude: "var base = 1;", isolate: true)
+
+    assert_equal 2, @pool.eval("var leaked = 'secret'; base = 2; base").value
+    assert_equal ["undefined", 1], @pool.eval("[typeof leaked, base]").value
+    assert_equal 7, @pool.eval("x + 1", variables: { x: 6 }).value
+    assert_equal "undefined", @pool.eval("typeof x").value
+    assert_raises(MQuickJS::JavascriptError) { @pool.eval("throw new Error('boom')") }
+    assert_equal 0, @pool.stats[:crashes]
+  end
+
+  def test_backpressure
+    @pool = MQuickJS::WorkerPool.new(size: 1, max_queue: 0)
+    busy = Thread.new { @pool.eval("var t = Date.now(); while (Date.now() - t < 300) {}") }
+    sleep 0.1
+
+    assert_raises(MQuickJS::PoolBusyError) { @pool.eval("1") }
+    busy.join
+  end
+end